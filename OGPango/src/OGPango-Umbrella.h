@@ -18,3 +18,10 @@
 #import "OGPangoFontsetSimple.h"
 #import "OGPangoLayout.h"
 #import "OGPangoRenderer.h"
+
+// Additional classes
+#import "OGPangoDisplayList.h"
+#import "OGPangoLayoutCache.h"
+#import "OGPangoLayoutDiskCache.h"
+#import "OGPangoRecordingRenderer.h"
+#import "OGPangoTextMeasurer.h"
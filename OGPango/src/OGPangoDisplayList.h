@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pango.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGPangoRenderer;
+
+/**
+ * The kind of a recorded drawing operation.
+ */
+typedef enum {
+	OGPangoDisplayOpGlyphs,
+	OGPangoDisplayOpRectangle,
+	OGPangoDisplayOpErrorUnderline,
+	OGPangoDisplayOpTrapezoid
+} OGPangoDisplayOpKind;
+
+/**
+ * A single drawing operation recorded by an `OGPangoRecordingRenderer`.
+ *
+ * All coordinates are in Pango units, except for the trapezoid coordinates
+ * which are in device units like in [method@Pango.Renderer.draw_trapezoid].
+ */
+typedef struct {
+	OGPangoDisplayOpKind kind;
+	PangoRenderPart part;
+	bool hasColor;
+	PangoColor color;
+	guint16 alpha;
+	/* OGPangoDisplayOpGlyphs */
+	PangoFont* font;
+	PangoGlyphString* glyphs;
+	/* OGPangoDisplayOpGlyphs, Rectangle and ErrorUnderline */
+	int x;
+	int y;
+	/* OGPangoDisplayOpRectangle and ErrorUnderline */
+	int width;
+	int height;
+	/* OGPangoDisplayOpTrapezoid */
+	double y1;
+	double x11;
+	double x21;
+	double y2;
+	double x12;
+	double x22;
+} OGPangoDisplayOp;
+
+/**
+ * An immutable list of drawing operations captured from a `PangoLayout` by an
+ * `OGPangoRecordingRenderer`.
+ *
+ * Replaying a display list draws the captured glyph strings and decorations
+ * with their captured colors without walking the runs of the layout again.
+ */
+@interface OGPangoDisplayList : OFObject
+{
+	GArray* _ops;
+}
+
+/**
+ * Initializes a display list, taking ownership of the operations.
+ *
+ * @param ops a `GArray` of `OGPangoDisplayOp`
+ * @return an initialized display list
+ */
+- (instancetype)initWithOps:(GArray*)ops;
+
+/**
+ * Methods
+ */
+
+/**
+ * Draws the recorded operations with the specified renderer.
+ *
+ * The colors of the renderer are changed to the recorded ones while drawing
+ * and are restored afterwards.
+ *
+ * @param renderer the renderer to draw with
+ * @param x X offset in Pango units
+ * @param y Y offset in Pango units
+ */
+- (void)replayWithRenderer:(OGPangoRenderer*)renderer x:(int)x y:(int)y;
+
+/**
+ * The number of recorded operations.
+ *
+ * @return the number of recorded operations
+ */
+- (size_t)count;
+
+/**
+ * The recorded operations.
+ *
+ * @return an array of -count operations, owned by the display list
+ */
+- (const OGPangoDisplayOp*)ops;
+
+@end
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGPangoDisplayList.h"
+
+#import "OGPangoRenderer.h"
+
+#define OG_PANGO_RENDER_PART_COUNT (PANGO_RENDER_PART_OVERLINE + 1)
+
+@implementation OGPangoDisplayList
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithOps:(GArray*)ops
+{
+	self = [super init];
+
+	@try {
+		if (ops == NULL)
+			@throw [OFInvalidArgumentException exception];
+
+		_ops = ops;
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	if (_ops != NULL)
+		g_array_unref(_ops);
+
+	[super dealloc];
+}
+
+- (void)replayWithRenderer:(OGPangoRenderer*)renderer x:(int)x y:(int)y
+{
+	PangoRenderer* gRenderer = [renderer castedGObject];
+	PangoColor savedColors[OG_PANGO_RENDER_PART_COUNT];
+	bool hadColors[OG_PANGO_RENDER_PART_COUNT];
+	guint16 savedAlphas[OG_PANGO_RENDER_PART_COUNT];
+	double dx = (double)x / PANGO_SCALE, dy = (double)y / PANGO_SCALE;
+
+	for (int part = 0; part < OG_PANGO_RENDER_PART_COUNT; part++) {
+		PangoColor* color = pango_renderer_get_color(gRenderer, part);
+
+		hadColors[part] = (color != NULL);
+		if (color != NULL)
+			savedColors[part] = *color;
+		savedAlphas[part] = pango_renderer_get_alpha(gRenderer, part);
+	}
+
+	pango_renderer_activate(gRenderer);
+
+	for (guint i = 0; i < _ops->len; i++) {
+		const OGPangoDisplayOp* op = &g_array_index(_ops, OGPangoDisplayOp, i);
+
+		pango_renderer_set_color(gRenderer, op->part, (op->hasColor ? &op->color : NULL));
+		pango_renderer_set_alpha(gRenderer, op->part, op->alpha);
+
+		switch (op->kind) {
+		case OGPangoDisplayOpGlyphs:
+			pango_renderer_draw_glyphs(gRenderer, op->font, op->glyphs, op->x + x, op->y + y);
+			break;
+		case OGPangoDisplayOpRectangle:
+			pango_renderer_draw_rectangle(gRenderer, op->part, op->x + x, op->y + y, op->width, op->height);
+			break;
+		case OGPangoDisplayOpErrorUnderline:
+			pango_renderer_draw_error_underline(gRenderer, op->x + x, op->y + y, op->width, op->height);
+			break;
+		case OGPangoDisplayOpTrapezoid:
+			pango_renderer_draw_trapezoid(gRenderer, op->part, op->y1 + dy, op->x11 + dx, op->x21 + dx, op->y2 + dy, op->x12 + dx, op->x22 + dx);
+			break;
+		}
+	}
+
+	pango_renderer_deactivate(gRenderer);
+
+	for (int part = 0; part < OG_PANGO_RENDER_PART_COUNT; part++) {
+		pango_renderer_set_color(gRenderer, part, (hadColors[part] ? &savedColors[part] : NULL));
+		pango_renderer_set_alpha(gRenderer, part, savedAlphas[part]);
+	}
+}
+
+- (size_t)count
+{
+	return _ops->len;
+}
+
+- (const OGPangoDisplayOp*)ops
+{
+	return (const OGPangoDisplayOp*)_ops->data;
+}
+
+@end
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pango.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGPangoContext;
+@class OGPangoLayout;
+
+/**
+ * An `OGPangoLayoutCache` hands out shared, already shaped `PangoLayout`s
+ * for a `PangoContext`.
+ *
+ * Entries are keyed on the text, the font description, the width, the wrap
+ * mode and the ellipsize mode. The pixel extents and the baseline of every
+ * layout are computed once when the layout is created, so measuring the same
+ * string again does not reshape it.
+ *
+ * The cache is bounded by an approximate byte budget. When the budget is
+ * exceeded, the least recently used layouts are dropped. All entries are
+ * dropped as soon as the serial of the context or of its font map changes.
+ *
+ * Layouts returned by the cache are shared and must not be modified. Use
+ * -[OGPangoLayout copy] if a modified layout is needed.
+ *
+ * The cache is not thread-safe and is meant to be used from the thread that
+ * owns the context, usually the main thread.
+ */
+@interface OGPangoLayoutCache : OFObject
+{
+	OGPangoContext* _context;
+	size_t _byteBudget;
+	size_t _bytesUsed;
+	guint _contextSerial;
+	guint _fontMapSerial;
+	OFMutableDictionary* _entries;
+	id _mostRecentlyUsed;
+	id _leastRecentlyUsed;
+	size_t _hits;
+	size_t _misses;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)cacheWithContext:(OGPangoContext*)context byteBudget:(size_t)byteBudget;
+
+/**
+ * Initializes a layout cache for the specified context.
+ *
+ * @param context the `PangoContext` to create the layouts with
+ * @param byteBudget the approximate number of bytes the cached layouts may use
+ * @return an initialized layout cache
+ */
+- (instancetype)initWithContext:(OGPangoContext*)context byteBudget:(size_t)byteBudget;
+
+/**
+ * Methods
+ */
+
+/**
+ * Returns a shared layout for the specified text and formatting parameters.
+ *
+ * The layout is created and shaped if it is not cached yet.
+ *
+ * @param text the text of the layout
+ * @param desc the font description, or %NULL to use the one of the context
+ * @param width the width in Pango units, or -1 for no width
+ * @param wrap the wrap mode
+ * @param ellipsize the ellipsize mode
+ * @return a shared layout that must not be modified
+ */
+- (OGPangoLayout*)layoutWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize;
+
+/**
+ * Returns the precomputed extents of the layout for the specified text and
+ * formatting parameters.
+ *
+ * This is equivalent to calling -[OGPangoLayout pixelExtentsWithInkRect:logicalRect:]
+ * and -[OGPangoLayout baseline] on the layout returned by
+ * -layoutWithText:fontDescription:width:wrap:ellipsize:, but does not query
+ * the layout again on a cache hit.
+ *
+ * @param text the text of the layout
+ * @param desc the font description, or %NULL to use the one of the context
+ * @param width the width in Pango units, or -1 for no width
+ * @param wrap the wrap mode
+ * @param ellipsize the ellipsize mode
+ * @param inkRect rectangle used to store the extents of the glyph
+ *   as drawn in pixels, or %NULL
+ * @param logicalRect rectangle used to store the logical extents of the
+ *   layout in pixels, or %NULL
+ * @param baseline location to store the baseline of the first line in Pango
+ *   units, or %NULL
+ */
+- (void)pixelExtentsWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize inkRect:(PangoRectangle*)inkRect logicalRect:(PangoRectangle*)logicalRect baseline:(int*)baseline;
+
+/**
+ * Convenience wrapper around
+ * -pixelExtentsWithText:fontDescription:width:wrap:ellipsize:inkRect:logicalRect:baseline:
+ * mirroring -[OGPangoLayout pixelSizeWithWidth:height:].
+ *
+ * @param text the text of the layout
+ * @param desc the font description, or %NULL to use the one of the context
+ * @param layoutWidth the width in Pango units, or -1 for no width
+ * @param wrap the wrap mode
+ * @param ellipsize the ellipsize mode
+ * @param width location to store the logical width in pixels, or %NULL
+ * @param height location to store the logical height in pixels, or %NULL
+ */
+- (void)pixelSizeWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc layoutWidth:(int)layoutWidth wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize width:(int*)width height:(int*)height;
+
+/**
+ * Drops all cached layouts.
+ */
+- (void)removeAllLayouts;
+
+/**
+ * Drops all cached layouts if the serial of the context or of its font map
+ * changed since the cache was last validated.
+ *
+ * This is done automatically on every lookup.
+ *
+ * @return %TRUE if the cache was invalidated
+ */
+- (bool)validate;
+
+/**
+ * The context the layouts are created with.
+ *
+ * @return the context
+ */
+- (OGPangoContext*)context;
+
+/**
+ * The approximate number of bytes the cached layouts may use.
+ *
+ * @return the byte budget
+ */
+- (size_t)byteBudget;
+
+/**
+ * Sets the approximate number of bytes the cached layouts may use, evicting
+ * least recently used layouts if necessary.
+ *
+ * @param byteBudget the new byte budget
+ */
+- (void)setByteBudget:(size_t)byteBudget;
+
+/**
+ * The approximate number of bytes currently used by cached layouts.
+ *
+ * @return the number of bytes used
+ */
+- (size_t)bytesUsed;
+
+/**
+ * The number of cached layouts.
+ *
+ * @return the number of cached layouts
+ */
+- (size_t)count;
+
+/**
+ * The number of lookups that were served from the cache.
+ *
+ * @return the number of cache hits
+ */
+- (size_t)hits;
+
+/**
+ * The number of lookups that required creating a new layout.
+ *
+ * @return the number of cache misses
+ */
+- (size_t)misses;
+
+@end
@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGPangoLayoutCache.h"
+
+#import "OGPangoContext.h"
+#import "OGPangoFontMap.h"
+#import "OGPangoLayout.h"
+
+/*
+ * Rough estimate of what a shaped layout costs: a fixed overhead for the
+ * layout, its lines and runs plus the log attributes, glyph infos and log
+ * clusters for every byte of text.
+ */
+#define OG_LAYOUT_CACHE_FIXED_COST 1024
+#define OG_LAYOUT_CACHE_COST_PER_BYTE 48
+
+@interface OGPangoLayoutCacheKey: OFObject <OFCopying>
+{
+@public
+	OFString* _text;
+	PangoFontDescription* _desc;
+	int _width;
+	PangoWrapMode _wrap;
+	PangoEllipsizeMode _ellipsize;
+	unsigned long _hash;
+}
+
+- (instancetype)initWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize;
+@end
+
+@interface OGPangoLayoutCacheEntry: OFObject
+{
+@public
+	OGPangoLayoutCacheKey* _key;
+	OGPangoLayout* _layout;
+	PangoRectangle _inkRect;
+	PangoRectangle _logicalRect;
+	int _baseline;
+	size_t _cost;
+	/* Not retained, the entries are owned by the dictionary. */
+	OGPangoLayoutCacheEntry* _previous;
+	OGPangoLayoutCacheEntry* _next;
+}
+@end
+
+@implementation OGPangoLayoutCacheKey
+
+- (instancetype)initWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize
+{
+	self = [super init];
+
+	@try {
+		_text = [text copy];
+		if (desc != NULL)
+			_desc = pango_font_description_copy(desc);
+		_width = width;
+		_wrap = wrap;
+		_ellipsize = ellipsize;
+
+		_hash = [_text hash];
+		_hash = _hash * 31 + (desc != NULL ? pango_font_description_hash(desc) : 0);
+		_hash = _hash * 31 + (unsigned long)width;
+		_hash = _hash * 31 + (unsigned long)wrap;
+		_hash = _hash * 31 + (unsigned long)ellipsize;
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_text release];
+	if (_desc != NULL)
+		pango_font_description_free(_desc);
+
+	[super dealloc];
+}
+
+- (id)copy
+{
+	return [self retain];
+}
+
+- (unsigned long)hash
+{
+	return _hash;
+}
+
+- (bool)isEqual:(id)object
+{
+	OGPangoLayoutCacheKey* other;
+
+	if (object == self)
+		return true;
+
+	if (![object isKindOfClass:[OGPangoLayoutCacheKey class]])
+		return false;
+
+	other = object;
+
+	if (other->_hash != _hash || other->_width != _width ||
+	    other->_wrap != _wrap || other->_ellipsize != _ellipsize)
+		return false;
+
+	if ((_desc == NULL) != (other->_desc == NULL))
+		return false;
+
+	if (_desc != NULL && !pango_font_description_equal(_desc, other->_desc))
+		return false;
+
+	return [other->_text isEqual:_text];
+}
+
+@end
+
+@implementation OGPangoLayoutCacheEntry
+
+- (void)dealloc
+{
+	[_key release];
+	[_layout release];
+
+	[super dealloc];
+}
+
+@end
+
+@implementation OGPangoLayoutCache
+
++ (instancetype)cacheWithContext:(OGPangoContext*)context byteBudget:(size_t)byteBudget
+{
+	return [[[self alloc] initWithContext:context byteBudget:byteBudget] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithContext:(OGPangoContext*)context byteBudget:(size_t)byteBudget
+{
+	self = [super init];
+
+	@try {
+		if (context == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		_context = [context retain];
+		_byteBudget = byteBudget;
+		_entries = [[OFMutableDictionary alloc] init];
+		_contextSerial = [_context serial];
+		_fontMapSerial = [[_context fontMap] serial];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_entries release];
+	[_context release];
+
+	[super dealloc];
+}
+
+- (void)unlinkEntry:(OGPangoLayoutCacheEntry*)entry
+{
+	if (entry->_previous != nil)
+		entry->_previous->_next = entry->_next;
+	else
+		_mostRecentlyUsed = entry->_next;
+
+	if (entry->_next != nil)
+		entry->_next->_previous = entry->_previous;
+	else
+		_leastRecentlyUsed = entry->_previous;
+
+	entry->_previous = nil;
+	entry->_next = nil;
+}
+
+- (void)linkEntryAsMostRecentlyUsed:(OGPangoLayoutCacheEntry*)entry
+{
+	OGPangoLayoutCacheEntry* head = _mostRecentlyUsed;
+
+	entry->_previous = nil;
+	entry->_next = head;
+
+	if (head != nil)
+		head->_previous = entry;
+	else
+		_leastRecentlyUsed = entry;
+
+	_mostRecentlyUsed = entry;
+}
+
+- (void)evictToBudget
+{
+	while (_bytesUsed > _byteBudget && _leastRecentlyUsed != nil) {
+		OGPangoLayoutCacheEntry* victim = _leastRecentlyUsed;
+
+		[self unlinkEntry:victim];
+		_bytesUsed -= victim->_cost;
+		[_entries removeObjectForKey:victim->_key];
+	}
+}
+
+- (OGPangoLayoutCacheEntry*)entryWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize
+{
+	OGPangoLayoutCacheKey* key;
+	OGPangoLayoutCacheEntry* entry;
+	OGPangoLayout* layout;
+
+	if (text == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	[self validate];
+
+	key = [[OGPangoLayoutCacheKey alloc] initWithText:text fontDescription:desc width:width wrap:wrap ellipsize:ellipsize];
+	@try {
+		entry = [_entries objectForKey:key];
+		if (entry != nil) {
+			_hits++;
+
+			if (entry != _mostRecentlyUsed) {
+				[self unlinkEntry:entry];
+				[self linkEntryAsMostRecentlyUsed:entry];
+			}
+
+			return entry;
+		}
+
+		_misses++;
+
+		layout = [OGPangoLayout layoutWithContext:_context];
+		if (desc != NULL)
+			[layout setFontDescription:desc];
+		[layout setWidth:width];
+		[layout setWrap:wrap];
+		[layout setEllipsize:ellipsize];
+		[layout setText:text length:-1];
+
+		entry = [[[OGPangoLayoutCacheEntry alloc] init] autorelease];
+		entry->_key = [key retain];
+		entry->_layout = [layout retain];
+		/* Shapes the layout once, later queries are answered from the entry. */
+		[layout pixelExtentsWithInkRect:&entry->_inkRect logicalRect:&entry->_logicalRect];
+		entry->_baseline = [layout baseline];
+		entry->_cost = OG_LAYOUT_CACHE_FIXED_COST + [text UTF8StringLength] * OG_LAYOUT_CACHE_COST_PER_BYTE;
+
+		[_entries setObject:entry forKey:key];
+		[self linkEntryAsMostRecentlyUsed:entry];
+		_bytesUsed += entry->_cost;
+	} @finally {
+		[key release];
+	}
+
+	/*
+	 * The entry is autoreleased above, so it stays valid for the caller even
+	 * if it alone exceeds the budget and is evicted right away.
+	 */
+	[self evictToBudget];
+
+	return entry;
+}
+
+- (OGPangoLayout*)layoutWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize
+{
+	OGPangoLayoutCacheEntry* entry = [self entryWithText:text fontDescription:desc width:width wrap:wrap ellipsize:ellipsize];
+
+	return [[entry->_layout retain] autorelease];
+}
+
+- (void)pixelExtentsWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize inkRect:(PangoRectangle*)inkRect logicalRect:(PangoRectangle*)logicalRect baseline:(int*)baseline
+{
+	OGPangoLayoutCacheEntry* entry = [self entryWithText:text fontDescription:desc width:width wrap:wrap ellipsize:ellipsize];
+
+	if (inkRect != NULL)
+		*inkRect = entry->_inkRect;
+	if (logicalRect != NULL)
+		*logicalRect = entry->_logicalRect;
+	if (baseline != NULL)
+		*baseline = entry->_baseline;
+}
+
+- (void)pixelSizeWithText:(OFString*)text fontDescription:(const PangoFontDescription*)desc layoutWidth:(int)layoutWidth wrap:(PangoWrapMode)wrap ellipsize:(PangoEllipsizeMode)ellipsize width:(int*)width height:(int*)height
+{
+	PangoRectangle logicalRect;
+
+	[self pixelExtentsWithText:text fontDescription:desc width:layoutWidth wrap:wrap ellipsize:ellipsize inkRect:NULL logicalRect:&logicalRect baseline:NULL];
+
+	if (width != NULL)
+		*width = logicalRect.width;
+	if (height != NULL)
+		*height = logicalRect.height;
+}
+
+- (void)removeAllLayouts
+{
+	_mostRecentlyUsed = nil;
+	_leastRecentlyUsed = nil;
+	_bytesUsed = 0;
+	[_entries removeAllObjects];
+}
+
+- (bool)validate
+{
+	guint contextSerial = [_context serial];
+	guint fontMapSerial = [[_context fontMap] serial];
+
+	if (contextSerial == _contextSerial && fontMapSerial == _fontMapSerial)
+		return false;
+
+	_contextSerial = contextSerial;
+	_fontMapSerial = fontMapSerial;
+	[self removeAllLayouts];
+
+	return true;
+}
+
+- (OGPangoContext*)context
+{
+	return _context;
+}
+
+- (size_t)byteBudget
+{
+	return _byteBudget;
+}
+
+- (void)setByteBudget:(size_t)byteBudget
+{
+	_byteBudget = byteBudget;
+	[self evictToBudget];
+}
+
+- (size_t)bytesUsed
+{
+	return _bytesUsed;
+}
+
+- (size_t)count
+{
+	return [_entries count];
+}
+
+- (size_t)hits
+{
+	return _hits;
+}
+
+- (size_t)misses
+{
+	return _misses;
+}
+
+@end
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pango.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGPangoContext;
+@class OGPangoLayout;
+
+/**
+ * An `OGPangoLayoutDiskCache` persists layouts built from markup in a
+ * directory, using [method@Pango.Layout.serialize] and
+ * [func@Pango.Layout.deserialize].
+ *
+ * Entries are keyed on a SHA-256 hash of the markup, the layout parameters
+ * and the Pango version, since the serialization format is only guaranteed
+ * to be understood by the Pango version that wrote it. A warm lookup maps the
+ * serialized file into memory and deserializes it, which skips parsing the
+ * markup again.
+ *
+ * The serialized form only contains the text, the attributes and the layout
+ * parameters, not the shaping results, so the returned layouts are always
+ * shaped with the current fonts of the context. Entries therefore stay valid
+ * when the font map changes.
+ *
+ * Unreadable or corrupt entries are removed and rebuilt transparently.
+ */
+@interface OGPangoLayoutDiskCache : OFObject
+{
+	OGPangoContext* _context;
+	OFString* _directory;
+	size_t _hits;
+	size_t _misses;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)cacheWithContext:(OGPangoContext*)context directory:(OFString*)directory;
+
+/**
+ * Initializes a layout disk cache, creating the directory if necessary.
+ *
+ * @param context the context to deserialize and create layouts with
+ * @param directory the directory to store the serialized layouts in, for
+ *   example a subdirectory of g_get_user_cache_dir()
+ * @return an initialized layout disk cache
+ */
+- (instancetype)initWithContext:(OGPangoContext*)context directory:(OFString*)directory;
+
+/**
+ * Methods
+ */
+
+/**
+ * Returns a layout for the specified markup, loading it from the cache if
+ * possible and storing it otherwise.
+ *
+ * The returned layout is owned by the caller and may be modified.
+ *
+ * @param markup the marked-up text
+ * @param desc the font description, or %NULL to use the one of the context
+ * @param width the width in Pango units, or -1 for no width
+ * @param wrap the wrap mode
+ * @return the layout
+ */
+- (OGPangoLayout*)layoutWithMarkup:(OFString*)markup fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap;
+
+/**
+ * Removes all serialized layouts from the cache directory.
+ */
+- (void)removeAllLayouts;
+
+/**
+ * The context the layouts are created with.
+ *
+ * @return the context
+ */
+- (OGPangoContext*)context;
+
+/**
+ * The directory the serialized layouts are stored in.
+ *
+ * @return the cache directory
+ */
+- (OFString*)directory;
+
+/**
+ * The number of lookups that were served from the cache.
+ *
+ * @return the number of cache hits
+ */
+- (size_t)hits;
+
+/**
+ * The number of lookups that required parsing the markup.
+ *
+ * @return the number of cache misses
+ */
+- (size_t)misses;
+
+@end
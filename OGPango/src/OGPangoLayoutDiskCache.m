@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <glib/gstdio.h>
+
+#import "OGPangoLayoutDiskCache.h"
+
+#import <OGObject/OGObject.h>
+
+#import "OGPangoContext.h"
+#import "OGPangoLayout.h"
+
+/* Bump whenever the key or the stored data changes. */
+#define OG_LAYOUT_DISK_CACHE_FORMAT 1
+#define OG_LAYOUT_DISK_CACHE_SUFFIX ".layout"
+
+@implementation OGPangoLayoutDiskCache
+
++ (instancetype)cacheWithContext:(OGPangoContext*)context directory:(OFString*)directory
+{
+	return [[[self alloc] initWithContext:context directory:directory] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithContext:(OGPangoContext*)context directory:(OFString*)directory
+{
+	self = [super init];
+
+	@try {
+		if (context == nil || directory == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		if (![[OFFileManager defaultManager] directoryExistsAtPath:directory])
+			[[OFFileManager defaultManager] createDirectoryAtPath:directory createParents:true];
+
+		_context = [context retain];
+		_directory = [directory copy];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_context release];
+	[_directory release];
+
+	[super dealloc];
+}
+
+- (char*)newPathForMarkup:(OFString*)markup fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap
+{
+	GChecksum* checksum = g_checksum_new(G_CHECKSUM_SHA256);
+	char* descString = (desc != NULL ? pango_font_description_to_string(desc) : NULL);
+	char* parameters = g_strdup_printf("%d\n%s\n%s\n%d\n%d\n", OG_LAYOUT_DISK_CACHE_FORMAT, pango_version_string(), (descString != NULL ? descString : ""), width, (int)wrap);
+	char* name;
+	char* path;
+
+	g_checksum_update(checksum, (const guchar*)parameters, -1);
+	g_checksum_update(checksum, (const guchar*)[markup UTF8String], [markup UTF8StringLength]);
+
+	name = g_strconcat(g_checksum_get_string(checksum), OG_LAYOUT_DISK_CACHE_SUFFIX, NULL);
+	path = g_build_filename([_directory UTF8String], name, NULL);
+
+	g_free(name);
+	g_free(parameters);
+	g_free(descString);
+	g_checksum_free(checksum);
+
+	return path;
+}
+
+- (OGPangoLayout*)loadLayoutAtPath:(const char*)path
+{
+	GMappedFile* file = g_mapped_file_new(path, FALSE, NULL);
+	GBytes* bytes;
+	OGPangoLayout* layout = nil;
+
+	if (file == NULL)
+		return nil;
+
+	bytes = g_mapped_file_get_bytes(file);
+	g_mapped_file_unref(file);
+
+	@try {
+		layout = [OGPangoLayout deserializeWithContext:_context bytes:bytes flags:PANGO_LAYOUT_DESERIALIZE_DEFAULT];
+	} @catch (OGErrorException* e) {
+		/* Written by a different Pango or truncated, rebuild it. */
+		g_unlink(path);
+	} @finally {
+		g_bytes_unref(bytes);
+	}
+
+	return layout;
+}
+
+- (OGPangoLayout*)layoutWithMarkup:(OFString*)markup fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap
+{
+	char* path;
+	OGPangoLayout* layout;
+	GBytes* bytes;
+
+	if (markup == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	path = [self newPathForMarkup:markup fontDescription:desc width:width wrap:wrap];
+
+	@try {
+		layout = [self loadLayoutAtPath:path];
+		if (layout != nil) {
+			_hits++;
+			return layout;
+		}
+
+		_misses++;
+
+		layout = [OGPangoLayout layoutWithContext:_context];
+		if (desc != NULL)
+			[layout setFontDescription:desc];
+		[layout setWidth:width];
+		[layout setWrap:wrap];
+		[layout setMarkup:markup length:-1];
+
+		bytes = [layout serializeWithFlags:PANGO_LAYOUT_SERIALIZE_DEFAULT];
+
+		/*
+		 * Failing to store the entry only costs a miss on the next
+		 * launch, so errors are ignored. g_file_set_contents() writes
+		 * to a temporary file and renames it, so readers never see a
+		 * partially written entry.
+		 */
+		g_file_set_contents(path, g_bytes_get_data(bytes, NULL), (gssize)g_bytes_get_size(bytes), NULL);
+		g_bytes_unref(bytes);
+	} @finally {
+		g_free(path);
+	}
+
+	return layout;
+}
+
+- (void)removeAllLayouts
+{
+	GDir* dir = g_dir_open([_directory UTF8String], 0, NULL);
+	const char* name;
+
+	if (dir == NULL)
+		return;
+
+	while ((name = g_dir_read_name(dir)) != NULL) {
+		char* path;
+
+		if (!g_str_has_suffix(name, OG_LAYOUT_DISK_CACHE_SUFFIX))
+			continue;
+
+		path = g_build_filename([_directory UTF8String], name, NULL);
+		g_unlink(path);
+		g_free(path);
+	}
+
+	g_dir_close(dir);
+}
+
+- (OGPangoContext*)context
+{
+	return _context;
+}
+
+- (OFString*)directory
+{
+	return _directory;
+}
+
+- (size_t)hits
+{
+	return _hits;
+}
+
+- (size_t)misses
+{
+	return _misses;
+}
+
+@end
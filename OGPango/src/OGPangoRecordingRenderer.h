@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pango.h>
+
+#import "OGPangoRenderer.h"
+
+@class OGPangoDisplayList;
+@class OGPangoLayout;
+
+#define OG_TYPE_PANGO_RECORDING_RENDERER (og_pango_recording_renderer_get_type())
+
+GType og_pango_recording_renderer_get_type(void);
+
+/**
+ * A `PangoRenderer` that does not draw anything, but captures the glyph
+ * strings, positions, decorations and colors of a layout into an
+ * `OGPangoDisplayList`.
+ *
+ * Static text can be recorded once and then be replayed with any other
+ * renderer through -[OGPangoDisplayList replayWithRenderer:x:y:], which does
+ * not walk the lines and runs of the layout again. The recorded glyph strings
+ * can also be turned into render nodes once and be cached.
+ *
+ * The renderer ignores its matrix; layouts should be recorded untransformed
+ * and be transformed when the display list is replayed.
+ */
+@interface OGPangoRecordingRenderer : OGPangoRenderer
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
++ (void)load;
+
++ (GTypeClass*)gObjectClass;
+
+/**
+ * Constructors
+ */
++ (instancetype)recordingRenderer;
+
+/**
+ * Methods
+ */
+
+/**
+ * Records the drawing operations of a layout.
+ *
+ * @param layout the layout to record
+ * @param x X position of the left edge of the layout in Pango units
+ * @param y Y position of the top edge of the layout in Pango units
+ * @return the recorded display list
+ */
+- (OGPangoDisplayList*)recordLayout:(OGPangoLayout*)layout x:(int)x y:(int)y;
+
+/**
+ * Records the drawing operations of a single layout line.
+ *
+ * @param line the line to record
+ * @param x X position of the left edge of the line in Pango units
+ * @param y Y position of the baseline in Pango units
+ * @return the recorded display list
+ */
+- (OGPangoDisplayList*)recordLayoutLine:(PangoLayoutLine*)line x:(int)x y:(int)y;
+
+@end
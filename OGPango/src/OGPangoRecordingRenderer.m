@@ -0,0 +1,211 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGPangoRecordingRenderer.h"
+
+#import "OGPangoDisplayList.h"
+#import "OGPangoLayout.h"
+
+typedef struct {
+	PangoRenderer parentInstance;
+	GArray* ops;
+} OGPangoRecordingRendererInstance;
+
+typedef struct {
+	PangoRendererClass parentClass;
+} OGPangoRecordingRendererInstanceClass;
+
+G_DEFINE_TYPE(OGPangoRecordingRendererInstance, og_pango_recording_renderer, PANGO_TYPE_RENDERER)
+
+static void
+clearOp(gpointer data)
+{
+	OGPangoDisplayOp* op = data;
+
+	if (op->glyphs != NULL)
+		pango_glyph_string_free(op->glyphs);
+	if (op->font != NULL)
+		g_object_unref(op->font);
+}
+
+static GArray*
+newOps(void)
+{
+	GArray* ops = g_array_new(FALSE, TRUE, sizeof(OGPangoDisplayOp));
+
+	g_array_set_clear_func(ops, clearOp);
+
+	return ops;
+}
+
+static OGPangoDisplayOp*
+appendOp(PangoRenderer* renderer, OGPangoDisplayOpKind kind, PangoRenderPart part)
+{
+	OGPangoRecordingRendererInstance* self = (OGPangoRecordingRendererInstance*)renderer;
+	PangoColor* color = pango_renderer_get_color(renderer, part);
+	OGPangoDisplayOp* op;
+
+	if (self->ops == NULL)
+		self->ops = newOps();
+
+	g_array_set_size(self->ops, self->ops->len + 1);
+	op = &g_array_index(self->ops, OGPangoDisplayOp, self->ops->len - 1);
+
+	op->kind = kind;
+	op->part = part;
+	op->hasColor = (color != NULL);
+	if (color != NULL)
+		op->color = *color;
+	op->alpha = pango_renderer_get_alpha(renderer, part);
+
+	return op;
+}
+
+static void
+recordGlyphs(PangoRenderer* renderer, PangoFont* font, PangoGlyphString* glyphs, int x, int y)
+{
+	OGPangoDisplayOp* op = appendOp(renderer, OGPangoDisplayOpGlyphs, PANGO_RENDER_PART_FOREGROUND);
+
+	op->font = g_object_ref(font);
+	op->glyphs = pango_glyph_string_copy(glyphs);
+	op->x = x;
+	op->y = y;
+}
+
+static void
+recordRectangle(PangoRenderer* renderer, PangoRenderPart part, int x, int y, int width, int height)
+{
+	OGPangoDisplayOp* op = appendOp(renderer, OGPangoDisplayOpRectangle, part);
+
+	op->x = x;
+	op->y = y;
+	op->width = width;
+	op->height = height;
+}
+
+static void
+recordErrorUnderline(PangoRenderer* renderer, int x, int y, int width, int height)
+{
+	OGPangoDisplayOp* op = appendOp(renderer, OGPangoDisplayOpErrorUnderline, PANGO_RENDER_PART_UNDERLINE);
+
+	op->x = x;
+	op->y = y;
+	op->width = width;
+	op->height = height;
+}
+
+static void
+recordTrapezoid(PangoRenderer* renderer, PangoRenderPart part, double y1, double x11, double x21, double y2, double x12, double x22)
+{
+	OGPangoDisplayOp* op = appendOp(renderer, OGPangoDisplayOpTrapezoid, part);
+
+	op->y1 = y1;
+	op->x11 = x11;
+	op->x21 = x21;
+	op->y2 = y2;
+	op->x12 = x12;
+	op->x22 = x22;
+}
+
+static void
+og_pango_recording_renderer_finalize(GObject* object)
+{
+	OGPangoRecordingRendererInstance* self = (OGPangoRecordingRendererInstance*)object;
+
+	if (self->ops != NULL)
+		g_array_unref(self->ops);
+
+	G_OBJECT_CLASS(og_pango_recording_renderer_parent_class)->finalize(object);
+}
+
+static void
+og_pango_recording_renderer_class_init(OGPangoRecordingRendererInstanceClass* klass)
+{
+	GObjectClass* objectClass = G_OBJECT_CLASS(klass);
+	PangoRendererClass* rendererClass = PANGO_RENDERER_CLASS(klass);
+
+	objectClass->finalize = og_pango_recording_renderer_finalize;
+
+	rendererClass->draw_glyphs = recordGlyphs;
+	rendererClass->draw_rectangle = recordRectangle;
+	rendererClass->draw_error_underline = recordErrorUnderline;
+	rendererClass->draw_trapezoid = recordTrapezoid;
+}
+
+static void
+og_pango_recording_renderer_init(OGPangoRecordingRendererInstance* self)
+{
+}
+
+@implementation OGPangoRecordingRenderer
+
+static GTypeClass *gObjectClass = NULL;
+
++ (void)load
+{
+	GType gtypeToAssociate = OG_TYPE_PANGO_RECORDING_RENDERER;
+
+	if (gtypeToAssociate == 0)
+		return;
+
+	g_type_set_qdata(gtypeToAssociate, [super wrapperQuark], [self class]);
+}
+
++ (GTypeClass*)gObjectClass
+{
+	if(gObjectClass != NULL)
+		return gObjectClass;
+
+	gObjectClass = g_type_class_ref(OG_TYPE_PANGO_RECORDING_RENDERER);
+	return gObjectClass;
+}
+
++ (instancetype)recordingRenderer
+{
+	PangoRenderer* gobjectValue = g_object_new(OG_TYPE_PANGO_RECORDING_RENDERER, NULL);
+
+	if OF_UNLIKELY(!gobjectValue)
+		@throw [OGObjectGObjectToWrapCreationFailedException exception];
+
+	OGPangoRecordingRenderer* wrapperObject;
+	@try {
+		wrapperObject = [[OGPangoRecordingRenderer alloc] initWithGObject:gobjectValue];
+	} @catch (id e) {
+		g_object_unref(gobjectValue);
+		[wrapperObject release];
+		@throw e;
+	}
+
+	g_object_unref(gobjectValue);
+	return [wrapperObject autorelease];
+}
+
+- (OGPangoDisplayList*)takeDisplayList
+{
+	OGPangoRecordingRendererInstance* instance = (OGPangoRecordingRendererInstance*)[self castedGObject];
+	GArray* ops = instance->ops;
+
+	instance->ops = NULL;
+	if (ops == NULL)
+		ops = newOps();
+
+	return [[[OGPangoDisplayList alloc] initWithOps:ops] autorelease];
+}
+
+- (OGPangoDisplayList*)recordLayout:(OGPangoLayout*)layout x:(int)x y:(int)y
+{
+	pango_renderer_draw_layout([self castedGObject], [layout castedGObject], x, y);
+
+	return [self takeDisplayList];
+}
+
+- (OGPangoDisplayList*)recordLayoutLine:(PangoLayoutLine*)line x:(int)x y:(int)y
+{
+	pango_renderer_draw_layout_line([self castedGObject], line, x, y);
+
+	return [self takeDisplayList];
+}
+
+@end
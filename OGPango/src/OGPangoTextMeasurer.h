@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pango.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGPangoFontMap;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block which is called on the main context once a batch of strings has
+ * been measured.
+ *
+ * The arrays are only valid for the duration of the block.
+ *
+ * @param widths the logical widths in pixels
+ * @param heights the logical heights in pixels
+ * @param baselines the baselines of the first lines in pixels
+ * @param count the number of measured strings
+ */
+typedef void (^OGPangoTextMeasurerCompletionHandler)(const int* widths, const int* heights, const int* baselines, size_t count);
+#endif
+
+/**
+ * An `OGPangoTextMeasurer` measures large batches of strings on a pool of
+ * worker threads.
+ *
+ * Every worker thread lazily creates its own `PangoContext` from the shared
+ * `PangoFontMap` and reuses a single `PangoLayout` for all strings it shapes,
+ * so no Pango object is ever used by two threads at the same time. The font
+ * map itself is shared by all worker contexts; pass a font map that is not
+ * reconfigured while batches are being measured.
+ *
+ * Each batch is split into chunks that are shaped in parallel. Results are
+ * returned as plain C arrays indexed like the input strings.
+ */
+@interface OGPangoTextMeasurer : OFObject
+{
+	OGPangoFontMap* _fontMap;
+	GThreadPool* _pool;
+	unsigned int _threadCount;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)measurerWithFontMap:(OGPangoFontMap*)fontMap threadCount:(unsigned int)threadCount;
+
+/**
+ * Initializes a text measurer.
+ *
+ * @param fontMap the font map the worker contexts are created from
+ * @param threadCount the number of worker threads, or 0 to use the number
+ *   of processors
+ * @return an initialized text measurer
+ */
+- (instancetype)initWithFontMap:(OGPangoFontMap*)fontMap threadCount:(unsigned int)threadCount;
+
+/**
+ * Methods
+ */
+
+/**
+ * Measures the specified strings in parallel and waits for the result.
+ *
+ * @param texts the strings to measure
+ * @param desc the font description to use, or %NULL for the context default
+ * @param width the width to wrap at in Pango units, or -1 for no wrapping
+ * @param wrap the wrap mode
+ * @param widths an array of `[texts count]` ints to store the logical widths
+ *   in pixels in, or %NULL
+ * @param heights an array of `[texts count]` ints to store the logical
+ *   heights in pixels in, or %NULL
+ * @param baselines an array of `[texts count]` ints to store the baselines
+ *   of the first lines in pixels in, or %NULL
+ */
+- (void)measureTexts:(OFArray OF_GENERIC(OFString*)*)texts fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap widths:(int*)widths heights:(int*)heights baselines:(int*)baselines;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Measures the specified strings in parallel without blocking.
+ *
+ * The handler is invoked on the thread-default main context of the calling
+ * thread once all strings have been measured.
+ *
+ * @param texts the strings to measure
+ * @param desc the font description to use, or %NULL for the context default
+ * @param width the width to wrap at in Pango units, or -1 for no wrapping
+ * @param wrap the wrap mode
+ * @param handler the block to call with the results
+ */
+- (void)asyncMeasureTexts:(OFArray OF_GENERIC(OFString*)*)texts fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap completionHandler:(OGPangoTextMeasurerCompletionHandler)handler;
+#endif
+
+/**
+ * The font map the worker contexts are created from.
+ *
+ * @return the font map
+ */
+- (OGPangoFontMap*)fontMap;
+
+/**
+ * The number of worker threads.
+ *
+ * @return the number of worker threads
+ */
+- (unsigned int)threadCount;
+
+@end
@@ -0,0 +1,325 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGPangoTextMeasurer.h"
+
+#import <OGObject/OGObject.h>
+
+#import "OGPangoFontMap.h"
+
+/* Smallest number of strings handed to a worker at once. */
+#define OG_MEASURE_MIN_CHUNK 64
+/* Number of chunks per worker thread, to even out differing string lengths. */
+#define OG_MEASURE_CHUNKS_PER_THREAD 4
+
+typedef struct {
+	PangoFontMap* fontMap;
+	PangoContext* context;
+	PangoLayout* layout;
+} OGMeasureWorkerState;
+
+typedef struct {
+	OFArray* texts;
+	PangoFontMap* fontMap;
+	PangoFontDescription* desc;
+	int width;
+	PangoWrapMode wrap;
+	size_t count;
+	int* widths;
+	int* heights;
+	int* baselines;
+	bool ownsResults;
+	gint pendingChunks;
+	GMutex mutex;
+	GCond cond;
+	bool done;
+#ifdef OF_HAVE_BLOCKS
+	GMainContext* mainContext;
+	OGPangoTextMeasurerCompletionHandler handler;
+#endif
+} OGMeasureBatch;
+
+typedef struct {
+	OGMeasureBatch* batch;
+	size_t start;
+	size_t end;
+} OGMeasureChunk;
+
+static void
+freeWorkerState(gpointer data)
+{
+	OGMeasureWorkerState* state = data;
+
+	g_object_unref(state->layout);
+	g_object_unref(state->context);
+	g_object_unref(state->fontMap);
+	g_free(state);
+}
+
+static GPrivate workerStateKey = G_PRIVATE_INIT(freeWorkerState);
+
+/*
+ * Returns the layout of the calling worker thread, creating the thread's
+ * context on first use.
+ */
+static PangoLayout*
+workerLayout(PangoFontMap* fontMap)
+{
+	OGMeasureWorkerState* state = g_private_get(&workerStateKey);
+
+	if (state != NULL && state->fontMap == fontMap)
+		return state->layout;
+
+	state = g_new0(OGMeasureWorkerState, 1);
+	state->fontMap = g_object_ref(fontMap);
+	state->context = pango_font_map_create_context(fontMap);
+	state->layout = pango_layout_new(state->context);
+	g_private_replace(&workerStateKey, state);
+
+	return state->layout;
+}
+
+static void
+freeBatch(OGMeasureBatch* batch)
+{
+	[batch->texts release];
+	g_object_unref(batch->fontMap);
+	if (batch->desc != NULL)
+		pango_font_description_free(batch->desc);
+
+	if (batch->ownsResults) {
+		g_free(batch->widths);
+		g_free(batch->heights);
+		g_free(batch->baselines);
+	}
+
+#ifdef OF_HAVE_BLOCKS
+	[batch->handler release];
+	if (batch->mainContext != NULL)
+		g_main_context_unref(batch->mainContext);
+#endif
+
+	g_cond_clear(&batch->cond);
+	g_mutex_clear(&batch->mutex);
+	g_free(batch);
+}
+
+#ifdef OF_HAVE_BLOCKS
+static gboolean
+deliverBatch(gpointer data)
+{
+	OGMeasureBatch* batch = data;
+	void* pool = objc_autoreleasePoolPush();
+
+	@try {
+		batch->handler(batch->widths, batch->heights, batch->baselines, batch->count);
+	} @finally {
+		freeBatch(batch);
+		objc_autoreleasePoolPop(pool);
+	}
+
+	return G_SOURCE_REMOVE;
+}
+#endif
+
+static void
+finishBatch(OGMeasureBatch* batch)
+{
+#ifdef OF_HAVE_BLOCKS
+	if (batch->handler != nil) {
+		g_main_context_invoke(batch->mainContext, deliverBatch, batch);
+		return;
+	}
+#endif
+
+	g_mutex_lock(&batch->mutex);
+	batch->done = true;
+	g_cond_signal(&batch->cond);
+	g_mutex_unlock(&batch->mutex);
+}
+
+static void
+measureChunk(gpointer data, gpointer userData)
+{
+	OGMeasureChunk* chunk = data;
+	OGMeasureBatch* batch = chunk->batch;
+	void* pool = objc_autoreleasePoolPush();
+	PangoLayout* layout = workerLayout(batch->fontMap);
+
+	pango_layout_set_font_description(layout, batch->desc);
+	pango_layout_set_width(layout, batch->width);
+	pango_layout_set_wrap(layout, batch->wrap);
+
+	for (size_t i = chunk->start; i < chunk->end; i++) {
+		PangoRectangle logicalRect;
+
+		pango_layout_set_text(layout, [[batch->texts objectAtIndex:i] UTF8String], -1);
+		pango_layout_get_pixel_extents(layout, NULL, &logicalRect);
+
+		if (batch->widths != NULL)
+			batch->widths[i] = logicalRect.width;
+		if (batch->heights != NULL)
+			batch->heights[i] = logicalRect.height;
+		if (batch->baselines != NULL)
+			batch->baselines[i] = PANGO_PIXELS(pango_layout_get_baseline(layout));
+	}
+
+	/* Do not keep the last string of the batch alive. */
+	pango_layout_set_text(layout, "", 0);
+
+	objc_autoreleasePoolPop(pool);
+	g_free(chunk);
+
+	if (g_atomic_int_dec_and_test(&batch->pendingChunks))
+		finishBatch(batch);
+}
+
+@implementation OGPangoTextMeasurer
+
++ (instancetype)measurerWithFontMap:(OGPangoFontMap*)fontMap threadCount:(unsigned int)threadCount
+{
+	return [[[self alloc] initWithFontMap:fontMap threadCount:threadCount] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithFontMap:(OGPangoFontMap*)fontMap threadCount:(unsigned int)threadCount
+{
+	self = [super init];
+
+	@try {
+		GError* err = NULL;
+
+		if (fontMap == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		if (threadCount == 0)
+			threadCount = g_get_num_processors();
+
+		_fontMap = [fontMap retain];
+		_threadCount = threadCount;
+		_pool = g_thread_pool_new(measureChunk, NULL, (gint)threadCount, TRUE, &err);
+
+		[OGErrorException throwForError:err];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	/* Lets queued chunks finish, their batches are still referenced. */
+	if (_pool != NULL)
+		g_thread_pool_free(_pool, FALSE, TRUE);
+
+	[_fontMap release];
+
+	[super dealloc];
+}
+
+- (OGMeasureBatch*)newBatchWithTexts:(OFArray*)texts fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap
+{
+	OGMeasureBatch* batch = g_new0(OGMeasureBatch, 1);
+
+	batch->texts = [texts copy];
+	batch->fontMap = g_object_ref([_fontMap castedGObject]);
+	batch->desc = (desc != NULL ? pango_font_description_copy(desc) : NULL);
+	batch->width = width;
+	batch->wrap = wrap;
+	batch->count = [texts count];
+	g_mutex_init(&batch->mutex);
+	g_cond_init(&batch->cond);
+
+	return batch;
+}
+
+- (void)submitBatch:(OGMeasureBatch*)batch
+{
+	size_t chunkSize, chunkCount;
+
+	if (batch->count == 0) {
+		finishBatch(batch);
+		return;
+	}
+
+	chunkSize = batch->count / (_threadCount * OG_MEASURE_CHUNKS_PER_THREAD);
+	if (chunkSize < OG_MEASURE_MIN_CHUNK)
+		chunkSize = OG_MEASURE_MIN_CHUNK;
+	chunkCount = (batch->count + chunkSize - 1) / chunkSize;
+
+	/* All chunks must be accounted for before the first one can finish. */
+	g_atomic_int_set(&batch->pendingChunks, (gint)chunkCount);
+
+	for (size_t i = 0; i < chunkCount; i++) {
+		OGMeasureChunk* chunk = g_new(OGMeasureChunk, 1);
+
+		chunk->batch = batch;
+		chunk->start = i * chunkSize;
+		chunk->end = MIN(chunk->start + chunkSize, batch->count);
+
+		/* Cannot fail, the threads of an exclusive pool already exist. */
+		g_thread_pool_push(_pool, chunk, NULL);
+	}
+}
+
+- (void)measureTexts:(OFArray OF_GENERIC(OFString*)*)texts fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap widths:(int*)widths heights:(int*)heights baselines:(int*)baselines
+{
+	OGMeasureBatch* batch;
+
+	if (texts == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	batch = [self newBatchWithTexts:texts fontDescription:desc width:width wrap:wrap];
+	batch->widths = widths;
+	batch->heights = heights;
+	batch->baselines = baselines;
+
+	[self submitBatch:batch];
+
+	g_mutex_lock(&batch->mutex);
+	while (!batch->done)
+		g_cond_wait(&batch->cond, &batch->mutex);
+	g_mutex_unlock(&batch->mutex);
+
+	freeBatch(batch);
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (void)asyncMeasureTexts:(OFArray OF_GENERIC(OFString*)*)texts fontDescription:(const PangoFontDescription*)desc width:(int)width wrap:(PangoWrapMode)wrap completionHandler:(OGPangoTextMeasurerCompletionHandler)handler
+{
+	OGMeasureBatch* batch;
+
+	if (texts == nil || handler == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	batch = [self newBatchWithTexts:texts fontDescription:desc width:width wrap:wrap];
+	batch->ownsResults = true;
+	batch->widths = g_new(int, MAX(batch->count, 1));
+	batch->heights = g_new(int, MAX(batch->count, 1));
+	batch->baselines = g_new(int, MAX(batch->count, 1));
+	batch->mainContext = g_main_context_ref_thread_default();
+	batch->handler = [handler copy];
+
+	[self submitBatch:batch];
+}
+#endif
+
+- (OGPangoFontMap*)fontMap
+{
+	return _fontMap;
+}
+
+- (unsigned int)threadCount
+{
+	return _threadCount;
+}
+
+@end
@@ -35,3 +35,13 @@
 #import "OGdkSurface.h"
 #import "OGdkTexture.h"
 #import "OGdkVulkanContext.h"
+
+// Additional classes
+#import "OGdkAnimationPaintable.h"
+#import "OGdkFrameBufferPool.h"
+#import "OGdkFrameQueuePaintable.h"
+#import "OGdkFrameStats.h"
+#import "OGdkPixelConverter.h"
+#import "OGdkTexture+OGAsyncEncoding.h"
+#import "OGdkTextureAtlas.h"
+#import "OGdkThumbnailCache.h"
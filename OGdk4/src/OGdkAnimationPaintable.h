@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <OGObject/OGObject.h>
+
+@class OGdkFrameClock;
+@class OGdkPixbufAnimation;
+
+#define OG_TYPE_GDK_ANIMATION_PAINTABLE (og_gdk_animation_paintable_get_type())
+
+GType og_gdk_animation_paintable_get_type(void);
+
+/**
+ * A `GdkPaintable` that plays a `GdkPixbufAnimation` from pre-decoded
+ * frames.
+ *
+ * Stepping a `GdkPixbufAnimationIter` composites the frame again on every
+ * step and every new pixbuf needs a new texture upload. This paintable
+ * decodes frames into premultiplied memory textures once:
+ *
+ *  - If a whole loop of the animation fits into the byte budget, all frames
+ *    are decoded when the paintable is created and the iterator is
+ *    discarded. Playing such an animation only looks up the frame for the
+ *    current frame time, and the renderer can keep the textures uploaded.
+ *  - Otherwise the paintable keeps a ring of as many frames as fit into the
+ *    budget and decodes at most two frames ahead per frame clock update,
+ *    skipping frames if it falls behind.
+ *
+ * A fully cached animation loops forever, unless its last frame has no
+ * delay. Playback is driven by the frame clock passed to
+ * -startWithFrameClock:, usually the one of the widget showing the
+ * paintable; the paintable is only invalidated when the frame changes.
+ */
+@interface OGdkAnimationPaintable : OGObject
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
++ (void)load;
+
++ (GTypeClass*)gObjectClass;
+
+/**
+ * Constructors
+ */
++ (instancetype)animationPaintableWithAnimation:(OGdkPixbufAnimation*)animation byteBudget:(size_t)byteBudget;
+
+/**
+ * Methods
+ */
+
+- (GdkPaintable*)castedGObject;
+
+/**
+ * Starts or resumes playback, advancing the animation on every update of a
+ * frame clock.
+ *
+ * @param frameClock the frame clock to drive the animation
+ */
+- (void)startWithFrameClock:(OGdkFrameClock*)frameClock;
+
+/**
+ * Stops playback and releases the frame clock.
+ */
+- (void)stop;
+
+/**
+ * Whether all frames of the animation are cached.
+ *
+ * @return whether the animation is fully cached
+ */
+- (bool)isFullyCached;
+
+/**
+ * The number of frames that are currently decoded.
+ *
+ * @return the number of cached frames
+ */
+- (size_t)cachedFrameCount;
+
+@end
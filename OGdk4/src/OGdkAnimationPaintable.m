@@ -0,0 +1,436 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkAnimationPaintable.h"
+
+#import <OGdkPixbuf/OGdkPixbufAnimation.h>
+
+#import "OGdkFrameClock.h"
+#import "OGdkPixelConverter.h"
+
+#define OG_ANIMATION_DEFAULT_BYTE_BUDGET (16 * 1024 * 1024)
+#define OG_ANIMATION_MAX_FRAMES 1024
+/* Frames decoded ahead per frame clock update when not fully cached. */
+#define OG_ANIMATION_DECODE_AHEAD 2
+/* Zero delays would never advance the iterator. */
+#define OG_ANIMATION_MIN_DELAY 10
+
+typedef struct {
+	GdkTexture* texture;
+	/* Milliseconds since the start of playback. */
+	gint64 start;
+	/* Milliseconds, or -1 if the frame is shown forever. */
+	int delay;
+} OGAnimationFrame;
+
+typedef struct {
+	GObject parentInstance;
+	int width;
+	int height;
+	OGAnimationFrame* frames;
+	unsigned int capacity;
+	unsigned int head;
+	unsigned int count;
+	bool fullyCached;
+	gint64 loopDuration;
+	GdkPixbufAnimationIter* iter;
+	gint64 producerTime;
+	bool iterEnded;
+	GdkTexture* current;
+	GdkFrameClock* frameClock;
+	gulong updateHandlerID;
+	gint64 startTime;
+	gint64 elapsed;
+} OGdkAnimationPaintableInstance;
+
+typedef struct {
+	GObjectClass parentClass;
+} OGdkAnimationPaintableInstanceClass;
+
+static void og_gdk_animation_paintable_paintable_init(GdkPaintableInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(OGdkAnimationPaintableInstance, og_gdk_animation_paintable, G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE(GDK_TYPE_PAINTABLE, og_gdk_animation_paintable_paintable_init))
+
+static inline OGAnimationFrame*
+frameAt(OGdkAnimationPaintableInstance* self, unsigned int index)
+{
+	return &self->frames[(self->head + index) % self->capacity];
+}
+
+static GdkTexture*
+newFrameTexture(GdkPixbuf* pixbuf)
+{
+	int channels = gdk_pixbuf_get_n_channels(pixbuf);
+	GdkTexture* texture;
+	GBytes* bytes;
+	size_t stride;
+
+	bytes = [OGdkPixelConverter bytesByConvertingPixels:gdk_pixbuf_read_pixels(pixbuf) format:(channels == 4 ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8) stride:gdk_pixbuf_get_rowstride(pixbuf) toFormat:GDK_MEMORY_R8G8B8A8_PREMULTIPLIED width:gdk_pixbuf_get_width(pixbuf) height:gdk_pixbuf_get_height(pixbuf) destinationStride:&stride];
+	texture = gdk_memory_texture_new(gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_height(pixbuf), GDK_MEMORY_R8G8B8A8_PREMULTIPLIED, bytes, stride);
+	g_bytes_unref(bytes);
+
+	return texture;
+}
+
+static void
+advanceIter(OGdkAnimationPaintableInstance* self, gint64 time)
+{
+	GTimeVal timeVal = { (glong)(time / 1000), (glong)(time % 1000) * 1000 };
+
+	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+	gdk_pixbuf_animation_iter_advance(self->iter, &timeVal);
+	G_GNUC_END_IGNORE_DEPRECATIONS
+
+	self->producerTime = time;
+}
+
+/*
+ * Whether the animation is at its first frame again after playing for the
+ * given time, i.e. the time is the duration of a loop.
+ *
+ * Frames may show the same image, and loaders may composite all frames
+ * into the same pixbuf, so neither the pixels nor the pixbuf identify a
+ * frame. Instead, an iterator at the start is advanced to the time in one
+ * step: advancing reports whether the iterator moved to another frame. A
+ * loader that always reports a change never completes a loop, so its
+ * frames are streamed instead of cached.
+ */
+static bool
+isLoopDuration(GdkPixbufAnimation* animation, gint64 time)
+{
+	GTimeVal startTime = { 0, 0 };
+	GTimeVal timeVal = { (glong)(time / 1000), (glong)(time % 1000) * 1000 };
+	GdkPixbufAnimationIter* iter;
+	bool frameChanged;
+
+	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+	iter = gdk_pixbuf_animation_get_iter(animation, &startTime);
+	frameChanged = gdk_pixbuf_animation_iter_advance(iter, &timeVal);
+	G_GNUC_END_IGNORE_DEPRECATIONS
+
+	g_object_unref(iter);
+
+	return !frameChanged;
+}
+
+/* Decodes the frame the iterator is at into the ring. */
+static void
+decodeNextFrame(OGdkAnimationPaintableInstance* self)
+{
+	GdkPixbuf* pixbuf = gdk_pixbuf_animation_iter_get_pixbuf(self->iter);
+	int delay = gdk_pixbuf_animation_iter_get_delay_time(self->iter);
+	OGAnimationFrame* frame;
+
+	frame = frameAt(self, self->count++);
+	frame->texture = newFrameTexture(pixbuf);
+	frame->start = self->producerTime;
+	frame->delay = delay;
+
+	if (delay < 0)
+		self->iterEnded = true;
+	else
+		advanceIter(self, self->producerTime + MAX(delay, OG_ANIMATION_MIN_DELAY));
+}
+
+static void
+popFrame(OGdkAnimationPaintableInstance* self)
+{
+	OGAnimationFrame* frame = frameAt(self, 0);
+
+	/* The current texture stays referenced by self->current. */
+	g_object_unref(frame->texture);
+	frame->texture = NULL;
+
+	self->head = (self->head + 1) % self->capacity;
+	self->count--;
+}
+
+static GdkTexture*
+textureForTime(OGdkAnimationPaintableInstance* self, gint64 elapsed)
+{
+	if (self->fullyCached) {
+		unsigned int low = 0, high = self->count;
+
+		if (self->loopDuration > 0)
+			elapsed %= self->loopDuration;
+
+		/* The last frame that started at or before the time. */
+		while (high - low > 1) {
+			unsigned int middle = (low + high) / 2;
+
+			if (self->frames[middle].start <= elapsed)
+				low = middle;
+			else
+				high = middle;
+		}
+
+		return self->frames[low].texture;
+	}
+
+	while (self->count >= 2 && frameAt(self, 1)->start <= elapsed)
+		popFrame(self);
+
+	/* Decoding fell behind, continue at the current time. */
+	if (self->count == 1 && !self->iterEnded && self->producerTime < elapsed && frameAt(self, 0)->start + frameAt(self, 0)->delay <= elapsed) {
+		advanceIter(self, elapsed);
+		decodeNextFrame(self);
+		popFrame(self);
+	}
+
+	for (int i = 0; i < OG_ANIMATION_DECODE_AHEAD && self->count < self->capacity && !self->iterEnded; i++)
+		decodeNextFrame(self);
+
+	return frameAt(self, 0)->texture;
+}
+
+static void
+stopPlayback(OGdkAnimationPaintableInstance* self)
+{
+	if (self->frameClock == NULL)
+		return;
+
+	g_signal_handler_disconnect(self->frameClock, self->updateHandlerID);
+	gdk_frame_clock_end_updating(self->frameClock);
+	g_clear_object(&self->frameClock);
+	self->startTime = 0;
+}
+
+static void
+frameClockUpdate(GdkFrameClock* frameClock, gpointer userData)
+{
+	OGdkAnimationPaintableInstance* self = userData;
+	gint64 frameTime = gdk_frame_clock_get_frame_time(frameClock);
+	GdkTexture* texture;
+	void* pool;
+
+	if (self->startTime == 0)
+		self->startTime = frameTime - self->elapsed * 1000;
+
+	self->elapsed = (frameTime - self->startTime) / 1000;
+
+	pool = objc_autoreleasePoolPush();
+	texture = textureForTime(self, self->elapsed);
+	objc_autoreleasePoolPop(pool);
+
+	if (texture != self->current) {
+		g_object_ref(texture);
+		g_clear_object(&self->current);
+		self->current = texture;
+
+		gdk_paintable_invalidate_contents(GDK_PAINTABLE(self));
+	}
+
+	/* The last frame of an animation that does not loop is final. */
+	if (self->fullyCached && self->loopDuration == 0 && texture == self->frames[self->count - 1].texture)
+		stopPlayback(self);
+}
+
+static void
+og_gdk_animation_paintable_snapshot(GdkPaintable* paintable, GdkSnapshot* snapshot, double width, double height)
+{
+	OGdkAnimationPaintableInstance* self = (OGdkAnimationPaintableInstance*)paintable;
+
+	if (self->current != NULL)
+		gdk_paintable_snapshot(GDK_PAINTABLE(self->current), snapshot, width, height);
+}
+
+static GdkPaintable*
+og_gdk_animation_paintable_get_current_image(GdkPaintable* paintable)
+{
+	OGdkAnimationPaintableInstance* self = (OGdkAnimationPaintableInstance*)paintable;
+
+	/* Textures are immutable, so the current one is the image. */
+	if (self->current != NULL)
+		return g_object_ref(GDK_PAINTABLE(self->current));
+
+	return gdk_paintable_new_empty(self->width, self->height);
+}
+
+static GdkPaintableFlags
+og_gdk_animation_paintable_get_flags(GdkPaintable* paintable)
+{
+	return GDK_PAINTABLE_STATIC_SIZE;
+}
+
+static int
+og_gdk_animation_paintable_get_intrinsic_width(GdkPaintable* paintable)
+{
+	return ((OGdkAnimationPaintableInstance*)paintable)->width;
+}
+
+static int
+og_gdk_animation_paintable_get_intrinsic_height(GdkPaintable* paintable)
+{
+	return ((OGdkAnimationPaintableInstance*)paintable)->height;
+}
+
+static void
+og_gdk_animation_paintable_paintable_init(GdkPaintableInterface* iface)
+{
+	iface->snapshot = og_gdk_animation_paintable_snapshot;
+	iface->get_current_image = og_gdk_animation_paintable_get_current_image;
+	iface->get_flags = og_gdk_animation_paintable_get_flags;
+	iface->get_intrinsic_width = og_gdk_animation_paintable_get_intrinsic_width;
+	iface->get_intrinsic_height = og_gdk_animation_paintable_get_intrinsic_height;
+}
+
+static void
+og_gdk_animation_paintable_finalize(GObject* object)
+{
+	OGdkAnimationPaintableInstance* self = (OGdkAnimationPaintableInstance*)object;
+
+	stopPlayback(self);
+
+	while (self->count > 0)
+		popFrame(self);
+
+	g_free(self->frames);
+	g_clear_object(&self->iter);
+	g_clear_object(&self->current);
+
+	G_OBJECT_CLASS(og_gdk_animation_paintable_parent_class)->finalize(object);
+}
+
+static void
+og_gdk_animation_paintable_class_init(OGdkAnimationPaintableInstanceClass* klass)
+{
+	G_OBJECT_CLASS(klass)->finalize = og_gdk_animation_paintable_finalize;
+}
+
+static void
+og_gdk_animation_paintable_init(OGdkAnimationPaintableInstance* self)
+{
+}
+
+@implementation OGdkAnimationPaintable
+
+static GTypeClass *gObjectClass = NULL;
+
++ (void)load
+{
+	GType gtypeToAssociate = OG_TYPE_GDK_ANIMATION_PAINTABLE;
+
+	if (gtypeToAssociate == 0)
+		return;
+
+	g_type_set_qdata(gtypeToAssociate, [super wrapperQuark], [self class]);
+}
+
++ (GTypeClass*)gObjectClass
+{
+	if(gObjectClass != NULL)
+		return gObjectClass;
+
+	gObjectClass = g_type_class_ref(OG_TYPE_GDK_ANIMATION_PAINTABLE);
+	return gObjectClass;
+}
+
++ (instancetype)animationPaintableWithAnimation:(OGdkPixbufAnimation*)animation byteBudget:(size_t)byteBudget
+{
+	GdkPixbufAnimation* gAnimation = [animation castedGObject];
+	OGdkAnimationPaintableInstance* instance;
+	size_t frameBytes;
+	GTimeVal startTime = { 0, 0 };
+
+	if (animation == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	if (byteBudget == 0)
+		byteBudget = OG_ANIMATION_DEFAULT_BYTE_BUDGET;
+
+	GdkPaintable* gobjectValue = g_object_new(OG_TYPE_GDK_ANIMATION_PAINTABLE, NULL);
+
+	if OF_UNLIKELY(!gobjectValue)
+		@throw [OGObjectGObjectToWrapCreationFailedException exception];
+
+	instance = (OGdkAnimationPaintableInstance*)gobjectValue;
+	instance->width = gdk_pixbuf_animation_get_width(gAnimation);
+	instance->height = gdk_pixbuf_animation_get_height(gAnimation);
+
+	frameBytes = MAX((size_t)instance->width * (size_t)instance->height * 4, 1);
+	instance->capacity = (unsigned int)MIN(MAX(byteBudget / frameBytes, 2), OG_ANIMATION_MAX_FRAMES);
+	instance->frames = g_new0(OGAnimationFrame, instance->capacity);
+
+	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+	instance->iter = gdk_pixbuf_animation_get_iter(gAnimation, &startTime);
+	G_GNUC_END_IGNORE_DEPRECATIONS
+
+	@try {
+		/* Decode until a loop is complete or the budget is used up. */
+		while (instance->count < instance->capacity && !instance->iterEnded) {
+			if (instance->count > 0 && isLoopDuration(gAnimation, instance->producerTime)) {
+				instance->loopDuration = instance->producerTime;
+				break;
+			}
+
+			decodeNextFrame(instance);
+		}
+	} @catch (id e) {
+		g_object_unref(gobjectValue);
+		@throw e;
+	}
+
+	if (instance->loopDuration > 0 || instance->iterEnded) {
+		instance->fullyCached = true;
+		g_clear_object(&instance->iter);
+	}
+
+	instance->current = g_object_ref(frameAt(instance, 0)->texture);
+
+	OGdkAnimationPaintable* wrapperObject;
+	@try {
+		wrapperObject = [[OGdkAnimationPaintable alloc] initWithGObject:gobjectValue];
+	} @catch (id e) {
+		g_object_unref(gobjectValue);
+		[wrapperObject release];
+		@throw e;
+	}
+
+	g_object_unref(gobjectValue);
+	return [wrapperObject autorelease];
+}
+
+- (GdkPaintable*)castedGObject
+{
+	return G_TYPE_CHECK_INSTANCE_CAST([self gObject], OG_TYPE_GDK_ANIMATION_PAINTABLE, GdkPaintable);
+}
+
+- (void)startWithFrameClock:(OGdkFrameClock*)frameClock
+{
+	OGdkAnimationPaintableInstance* instance = (OGdkAnimationPaintableInstance*)[self castedGObject];
+
+	if (frameClock == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	if (instance->frameClock == [frameClock castedGObject])
+		return;
+
+	stopPlayback(instance);
+
+	/* A single frame needs no updates. */
+	if (instance->fullyCached && instance->count == 1)
+		return;
+
+	instance->frameClock = g_object_ref([frameClock castedGObject]);
+	instance->updateHandlerID = g_signal_connect(instance->frameClock, "update", G_CALLBACK(frameClockUpdate), instance);
+	gdk_frame_clock_begin_updating(instance->frameClock);
+}
+
+- (void)stop
+{
+	stopPlayback((OGdkAnimationPaintableInstance*)[self castedGObject]);
+}
+
+- (bool)isFullyCached
+{
+	return ((OGdkAnimationPaintableInstance*)[self castedGObject])->fullyCached;
+}
+
+- (size_t)cachedFrameCount
+{
+	return ((OGdkAnimationPaintableInstance*)[self castedGObject])->count;
+}
+
+@end
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkMemoryTexture;
+
+/**
+ * The memory backing the buffers of an `OGdkFrameBufferPool`.
+ */
+typedef enum {
+	/** 64 byte aligned heap memory */
+	OGdkFrameBufferPoolBackingHeap,
+	/**
+	 * Anonymous mappings, using transparent huge pages for buffers of 2 MiB
+	 * and more where supported
+	 */
+	OGdkFrameBufferPoolBackingHugePages,
+	/**
+	 * Shared mappings of anonymous memory files, whose file descriptors can
+	 * be passed to other processes
+	 */
+	OGdkFrameBufferPoolBackingMemfd
+} OGdkFrameBufferPoolBacking;
+
+/**
+ * An `OGdkFrameBufferPool` recycles the memory behind the `GBytes` of memory
+ * textures.
+ *
+ * A video producer creating a new memory texture for every frame otherwise
+ * allocates and frees a frame sized buffer at the frame rate. Buffers
+ * acquired from the pool are returned to it as soon as the last reference
+ * to their `GBytes` is dropped, which happens when GTK releases the texture,
+ * and are handed out again by the next request of the same size class.
+ *
+ * Sizes are rounded up to size classes with four classes per power of two,
+ * so frames of slightly varying sizes share buffers with at most 25% waste.
+ * Each size class keeps a bounded number of free buffers; buffers released
+ * beyond that are freed.
+ *
+ * The pool is thread-safe. Buffers may outlive the pool, they are freed when
+ * they are released after the pool was deallocated.
+ */
+@interface OGdkFrameBufferPool : OFObject
+{
+	struct OGdkFrameBufferPoolState* _state;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)poolWithBacking:(OGdkFrameBufferPoolBacking)backing maxFreeBuffersPerSizeClass:(unsigned int)maxFreeBuffersPerSizeClass;
+
+/**
+ * Initializes a frame buffer pool.
+ *
+ * Memfd and huge page backings fall back to heap memory on platforms that
+ * do not support them.
+ *
+ * @param backing the memory to allocate buffers from
+ * @param maxFreeBuffersPerSizeClass the number of free buffers to keep per
+ *   size class, or 0 for 4
+ * @return an initialized frame buffer pool
+ */
+- (instancetype)initWithBacking:(OGdkFrameBufferPoolBacking)backing maxFreeBuffersPerSizeClass:(unsigned int)maxFreeBuffersPerSizeClass;
+
+/**
+ * Methods
+ */
+
+/**
+ * Acquires a buffer from the pool.
+ *
+ * The buffer may be written through the returned pointer until the bytes
+ * are handed to a texture or another consumer. Its contents are undefined.
+ *
+ * @param size the size of the buffer in bytes
+ * @param data location to store the writable pointer to the buffer
+ * @param fileDescriptor location to store the memfd of the buffer, or -1 if
+ *   it is not backed by a memfd; may be %NULL. The descriptor is owned by the
+ *   pool and must not be closed.
+ * @return the buffer, to be released with g_bytes_unref()
+ */
+- (GBytes*)acquireBytesWithSize:(size_t)size data:(void**)data fileDescriptor:(int*)fileDescriptor;
+
+/**
+ * Creates a memory texture in a pooled buffer by converting pixels with
+ * `OGdkPixelConverter`.
+ *
+ * @param source the source pixels
+ * @param sourceFormat the format of the source pixels
+ * @param sourceStride the distance between two source rows in bytes
+ * @param width the width in pixels
+ * @param height the height in pixels
+ * @param textureFormat the format of the texture, one of the 8 bit
+ *   destination formats of `OGdkPixelConverter`
+ * @return a new memory texture
+ */
+- (OGdkMemoryTexture*)memoryTextureWithPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride width:(int)width height:(int)height textureFormat:(GdkMemoryFormat)textureFormat;
+
+/**
+ * Frees all buffers that are currently unused.
+ */
+- (void)trim;
+
+/**
+ * The number of buffer requests that were served with a recycled buffer.
+ *
+ * @return the number of pool hits
+ */
+- (size_t)hits;
+
+/**
+ * The number of buffer requests that needed a new allocation.
+ *
+ * @return the number of pool misses
+ */
+- (size_t)misses;
+
+/**
+ * The total size of the unused buffers kept by the pool.
+ *
+ * @return the size of the free buffers in bytes
+ */
+- (size_t)freeBytes;
+
+@end
@@ -0,0 +1,374 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifdef __linux__
+# define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+
+#import "OGdkFrameBufferPool.h"
+
+#ifdef G_OS_UNIX
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#import "OGdkMemoryTexture.h"
+#import "OGdkPixelConverter.h"
+
+#define OG_FRAME_BUFFER_DEFAULT_MAX_FREE 4
+#define OG_FRAME_BUFFER_MIN_SIZE 4096
+#define OG_FRAME_BUFFER_ALIGNMENT 64
+#define OG_FRAME_BUFFER_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+# define OG_HAVE_MEMFD
+#endif
+
+#if defined(G_OS_UNIX) && defined(MAP_ANONYMOUS)
+# define OG_HAVE_ANONYMOUS_MMAP
+#endif
+
+struct OGdkFrameBufferPoolState {
+	GMutex mutex;
+	/* Size class -> GSList of free OGFrameBuffers */
+	GHashTable* freeBuffers;
+	OGdkFrameBufferPoolBacking backing;
+	unsigned int maxFreeBuffersPerSizeClass;
+	size_t hits;
+	size_t misses;
+	size_t freeBytes;
+	/* Set when the pool is deallocated, released buffers are then freed. */
+	bool closed;
+};
+
+typedef struct {
+	struct OGdkFrameBufferPoolState* pool;
+	void* data;
+	size_t size;
+	OGdkFrameBufferPoolBacking backing;
+	int fd;
+} OGFrameBuffer;
+
+/*
+ * Rounds up to one of four size classes per power of two, and at least to
+ * whole pages.
+ */
+static size_t
+sizeClassForSize(size_t size)
+{
+	size_t step;
+
+	if (size <= OG_FRAME_BUFFER_MIN_SIZE)
+		return OG_FRAME_BUFFER_MIN_SIZE;
+
+	step = MAX((size_t)1 << (g_bit_storage(size - 1) - 3), OG_FRAME_BUFFER_MIN_SIZE);
+
+	return (size + step - 1) & ~(step - 1);
+}
+
+static OGFrameBuffer*
+allocateBuffer(OGdkFrameBufferPoolBacking backing, size_t size)
+{
+	OGFrameBuffer* buffer = g_new0(OGFrameBuffer, 1);
+
+	buffer->size = size;
+	buffer->fd = -1;
+
+#ifdef OG_HAVE_MEMFD
+	if (backing == OGdkFrameBufferPoolBackingMemfd) {
+		int fd = memfd_create("ogdk-frame-buffer", MFD_CLOEXEC);
+
+		if (fd != -1) {
+			void* data = MAP_FAILED;
+
+			if (ftruncate(fd, (off_t)size) == 0)
+				data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+			if (data != MAP_FAILED) {
+				buffer->data = data;
+				buffer->fd = fd;
+				buffer->backing = backing;
+				return buffer;
+			}
+
+			close(fd);
+		}
+	}
+#endif
+
+#ifdef OG_HAVE_ANONYMOUS_MMAP
+	if (backing == OGdkFrameBufferPoolBackingHugePages) {
+		void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (data != MAP_FAILED) {
+# ifdef MADV_HUGEPAGE
+			if (size >= OG_FRAME_BUFFER_HUGE_PAGE_SIZE)
+				madvise(data, size, MADV_HUGEPAGE);
+# endif
+			buffer->data = data;
+			buffer->backing = backing;
+			return buffer;
+		}
+	}
+#endif
+
+	buffer->data = g_aligned_alloc(1, size, OG_FRAME_BUFFER_ALIGNMENT);
+	buffer->backing = OGdkFrameBufferPoolBackingHeap;
+
+	return buffer;
+}
+
+static void
+freeBuffer(OGFrameBuffer* buffer)
+{
+	switch (buffer->backing) {
+#ifdef OG_HAVE_ANONYMOUS_MMAP
+	case OGdkFrameBufferPoolBackingMemfd:
+	case OGdkFrameBufferPoolBackingHugePages:
+		munmap(buffer->data, buffer->size);
+		if (buffer->fd != -1)
+			close(buffer->fd);
+		break;
+#endif
+	default:
+		g_aligned_free(buffer->data);
+		break;
+	}
+
+	g_free(buffer);
+}
+
+static void
+freeBufferList(gpointer list)
+{
+	g_slist_free_full(list, (GDestroyNotify)freeBuffer);
+}
+
+static void
+clearState(gpointer data)
+{
+	struct OGdkFrameBufferPoolState* state = data;
+
+	g_hash_table_unref(state->freeBuffers);
+	g_mutex_clear(&state->mutex);
+}
+
+static void
+bufferReleased(gpointer data)
+{
+	OGFrameBuffer* buffer = data;
+	struct OGdkFrameBufferPoolState* state = buffer->pool;
+	gpointer key = GSIZE_TO_POINTER(buffer->size);
+	bool keep = false;
+
+	g_mutex_lock(&state->mutex);
+
+	if (!state->closed) {
+		GSList* list = g_hash_table_lookup(state->freeBuffers, key);
+
+		if (g_slist_length(list) < state->maxFreeBuffersPerSizeClass) {
+			g_hash_table_steal(state->freeBuffers, key);
+			g_hash_table_insert(state->freeBuffers, key, g_slist_prepend(list, buffer));
+			state->freeBytes += buffer->size;
+			keep = true;
+		}
+	}
+
+	g_mutex_unlock(&state->mutex);
+
+	if (!keep)
+		freeBuffer(buffer);
+
+	/* Every buffer handed out keeps the state alive. */
+	g_atomic_rc_box_release_full(state, clearState);
+}
+
+static size_t
+bytesPerPixel(GdkMemoryFormat format)
+{
+	switch (format) {
+	case GDK_MEMORY_R8G8B8:
+	case GDK_MEMORY_B8G8R8:
+		return 3;
+	case GDK_MEMORY_R8G8B8A8:
+	case GDK_MEMORY_B8G8R8A8:
+	case GDK_MEMORY_R8G8B8A8_PREMULTIPLIED:
+	case GDK_MEMORY_B8G8R8A8_PREMULTIPLIED:
+		return 4;
+	default:
+		@throw [OFInvalidArgumentException exception];
+	}
+}
+
+@implementation OGdkFrameBufferPool
+
++ (instancetype)poolWithBacking:(OGdkFrameBufferPoolBacking)backing maxFreeBuffersPerSizeClass:(unsigned int)maxFreeBuffersPerSizeClass
+{
+	return [[[self alloc] initWithBacking:backing maxFreeBuffersPerSizeClass:maxFreeBuffersPerSizeClass] autorelease];
+}
+
+- (instancetype)init
+{
+	return [self initWithBacking:OGdkFrameBufferPoolBackingHeap maxFreeBuffersPerSizeClass:0];
+}
+
+- (instancetype)initWithBacking:(OGdkFrameBufferPoolBacking)backing maxFreeBuffersPerSizeClass:(unsigned int)maxFreeBuffersPerSizeClass
+{
+	self = [super init];
+
+	@try {
+		if (backing != OGdkFrameBufferPoolBackingHeap && backing != OGdkFrameBufferPoolBackingHugePages && backing != OGdkFrameBufferPoolBackingMemfd)
+			@throw [OFInvalidArgumentException exception];
+
+		if (maxFreeBuffersPerSizeClass == 0)
+			maxFreeBuffersPerSizeClass = OG_FRAME_BUFFER_DEFAULT_MAX_FREE;
+
+		_state = g_atomic_rc_box_new0(struct OGdkFrameBufferPoolState);
+		g_mutex_init(&_state->mutex);
+		_state->freeBuffers = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, freeBufferList);
+		_state->backing = backing;
+		_state->maxFreeBuffersPerSizeClass = maxFreeBuffersPerSizeClass;
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	if (_state != NULL) {
+		g_mutex_lock(&_state->mutex);
+		_state->closed = true;
+		g_hash_table_remove_all(_state->freeBuffers);
+		_state->freeBytes = 0;
+		g_mutex_unlock(&_state->mutex);
+
+		g_atomic_rc_box_release_full(_state, clearState);
+	}
+
+	[super dealloc];
+}
+
+- (GBytes*)acquireBytesWithSize:(size_t)size data:(void**)data fileDescriptor:(int*)fileDescriptor
+{
+	size_t sizeClass = sizeClassForSize(size);
+	gpointer key = GSIZE_TO_POINTER(sizeClass);
+	OGFrameBuffer* buffer = NULL;
+	GSList* list;
+
+	if (data == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	g_mutex_lock(&_state->mutex);
+
+	list = g_hash_table_lookup(_state->freeBuffers, key);
+	if (list != NULL) {
+		buffer = list->data;
+
+		g_hash_table_steal(_state->freeBuffers, key);
+		list = g_slist_delete_link(list, list);
+		if (list != NULL)
+			g_hash_table_insert(_state->freeBuffers, key, list);
+
+		_state->freeBytes -= buffer->size;
+		_state->hits++;
+	} else
+		_state->misses++;
+
+	g_mutex_unlock(&_state->mutex);
+
+	if (buffer == NULL) {
+		buffer = allocateBuffer(_state->backing, sizeClass);
+
+		if (buffer->data == NULL) {
+			g_free(buffer);
+			@throw [OFOutOfMemoryException exceptionWithRequestedSize:sizeClass];
+		}
+	}
+
+	buffer->pool = g_atomic_rc_box_acquire(_state);
+
+	*data = buffer->data;
+	if (fileDescriptor != NULL)
+		*fileDescriptor = buffer->fd;
+
+	/* The bytes only cover the requested size, not the whole class. */
+	return g_bytes_new_with_free_func(buffer->data, size, bufferReleased, buffer);
+}
+
+- (OGdkMemoryTexture*)memoryTextureWithPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride width:(int)width height:(int)height textureFormat:(GdkMemoryFormat)textureFormat
+{
+	size_t stride, size;
+	OGdkMemoryTexture* texture;
+	GBytes* bytes;
+	void* data;
+
+	if (width <= 0 || height <= 0 || ![OGdkPixelConverter canConvertFromFormat:sourceFormat toFormat:textureFormat])
+		@throw [OFInvalidArgumentException exception];
+
+	stride = (size_t)width * bytesPerPixel(textureFormat);
+	if (SIZE_MAX / stride < (size_t)height)
+		@throw [OFOutOfRangeException exception];
+	size = stride * (size_t)height;
+
+	bytes = [self acquireBytesWithSize:size data:&data fileDescriptor:NULL];
+
+	@try {
+		[OGdkPixelConverter convertPixels:source format:sourceFormat stride:sourceStride toPixels:data format:textureFormat stride:stride width:width height:height];
+
+		texture = [OGdkMemoryTexture memoryTextureWithWidth:width height:height format:textureFormat bytes:bytes stride:stride];
+	} @finally {
+		g_bytes_unref(bytes);
+	}
+
+	return texture;
+}
+
+- (void)trim
+{
+	g_mutex_lock(&_state->mutex);
+	g_hash_table_remove_all(_state->freeBuffers);
+	_state->freeBytes = 0;
+	g_mutex_unlock(&_state->mutex);
+}
+
+- (size_t)hits
+{
+	size_t hits;
+
+	g_mutex_lock(&_state->mutex);
+	hits = _state->hits;
+	g_mutex_unlock(&_state->mutex);
+
+	return hits;
+}
+
+- (size_t)misses
+{
+	size_t misses;
+
+	g_mutex_lock(&_state->mutex);
+	misses = _state->misses;
+	g_mutex_unlock(&_state->mutex);
+
+	return misses;
+}
+
+- (size_t)freeBytes
+{
+	size_t freeBytes;
+
+	g_mutex_lock(&_state->mutex);
+	freeBytes = _state->freeBytes;
+	g_mutex_unlock(&_state->mutex);
+
+	return freeBytes;
+}
+
+@end
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <OGObject/OGObject.h>
+
+@class OGdkFrameClock;
+@class OGdkTexture;
+
+#define OG_TYPE_GDK_FRAME_QUEUE_PAINTABLE (og_gdk_frame_queue_paintable_get_type())
+
+GType og_gdk_frame_queue_paintable_get_type(void);
+
+/**
+ * Statistics of an `OGdkFrameQueuePaintable`.
+ *
+ * Latencies are measured from the timestamp of a frame to the frame time of
+ * the frame clock update that presented it, in microseconds.
+ */
+typedef struct {
+	/** The number of frames accepted into the queue */
+	guint64 pushedFrames;
+	/** The number of frames that were presented */
+	guint64 presentedFrames;
+	/** The number of frames replaced by a newer one before presentation */
+	guint64 staleFrames;
+	/** The number of frames rejected because the queue was full */
+	guint64 rejectedFrames;
+	/** The latency of the last presented frame */
+	gint64 lastLatency;
+	/** The average latency of all presented frames */
+	gint64 averageLatency;
+	/** The highest latency of all presented frames */
+	gint64 maxLatency;
+} OGdkFrameQueueStatistics;
+
+/**
+ * A `GdkPaintable` showing frames pushed by a producer thread, e.g. a
+ * software video decoder or a remote desktop client.
+ *
+ * Frames are passed through a lock-free single-producer, single-consumer
+ * ring buffer. Pushing a frame requests an update from the frame clock,
+ * unless one is already pending; on that update the paintable presents the
+ * newest queued frame and drops all older ones as stale. A producer that is
+ * faster than the display therefore never builds up latency, and an idle
+ * producer does not keep the frame clock running.
+ *
+ * -pushTexture:timestamp: may be called from any thread, but only from one
+ * thread at a time. Everything else must be called from the thread that
+ * created the paintable, whose thread-default main context must be running.
+ */
+@interface OGdkFrameQueuePaintable : OGObject
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
++ (void)load;
+
++ (GTypeClass*)gObjectClass;
+
+/**
+ * Constructors
+ */
++ (instancetype)frameQueuePaintableWithCapacity:(unsigned int)capacity;
+
+/**
+ * Methods
+ */
+
+- (GdkPaintable*)castedGObject;
+
+/**
+ * Queues a frame for presentation.
+ *
+ * @param texture the frame
+ * @param timestamp the time the frame was produced or captured, in the
+ *   time base of g_get_monotonic_time(), or 0 to use the current time
+ * @return whether the frame was queued, false if the queue was full
+ */
+- (bool)pushTexture:(OGdkTexture*)texture timestamp:(gint64)timestamp;
+
+/**
+ * Starts presenting frames on updates of a frame clock.
+ *
+ * @param frameClock the frame clock, usually the one of the widget showing
+ *   the paintable
+ */
+- (void)startWithFrameClock:(OGdkFrameClock*)frameClock;
+
+/**
+ * Stops presenting frames and releases the frame clock. Frames pushed in the
+ * meantime stay queued.
+ */
+- (void)stop;
+
+/**
+ * The statistics since the paintable was created or the statistics were
+ * reset.
+ *
+ * @return the statistics
+ */
+- (OGdkFrameQueueStatistics)statistics;
+
+/**
+ * Resets all statistics to zero.
+ */
+- (void)resetStatistics;
+
+@end
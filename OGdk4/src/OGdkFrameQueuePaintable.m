@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkFrameQueuePaintable.h"
+
+#import "OGdkFrameClock.h"
+#import "OGdkTexture.h"
+
+#define OG_FRAME_QUEUE_DEFAULT_CAPACITY 4
+#define OG_FRAME_QUEUE_MAX_CAPACITY 256
+
+typedef struct {
+	GdkTexture* texture;
+	gint64 timestamp;
+} OGQueuedFrame;
+
+typedef struct {
+	GObject parentInstance;
+	OGQueuedFrame* slots;
+	guint mask;
+	/* Only written by the consumer. */
+	gint head;
+	/* Only written by the producer. */
+	gint tail;
+	gint wakePending;
+	gint pushedFrames;
+	gint rejectedFrames;
+	GMainContext* mainContext;
+	GdkTexture* current;
+	GdkFrameClock* frameClock;
+	gulong updateHandlerID;
+	guint64 presentedFrames;
+	guint64 staleFrames;
+	gint64 lastLatency;
+	gint64 totalLatency;
+	gint64 maxLatency;
+} OGdkFrameQueuePaintableInstance;
+
+typedef struct {
+	GObjectClass parentClass;
+} OGdkFrameQueuePaintableInstanceClass;
+
+static void og_gdk_frame_queue_paintable_paintable_init(GdkPaintableInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(OGdkFrameQueuePaintableInstance, og_gdk_frame_queue_paintable, G_TYPE_OBJECT, G_IMPLEMENT_INTERFACE(GDK_TYPE_PAINTABLE, og_gdk_frame_queue_paintable_paintable_init))
+
+static void
+presentNewestFrame(OGdkFrameQueuePaintableInstance* self, gint64 frameTime)
+{
+	guint head = (guint)self->head;
+	guint tail = (guint)g_atomic_int_get(&self->tail);
+	OGQueuedFrame newest;
+	bool sizeChanged;
+
+	if (head == tail)
+		return;
+
+	/* Everything but the newest frame is stale. */
+	for (; head != tail - 1; head++) {
+		g_object_unref(self->slots[head & self->mask].texture);
+		self->slots[head & self->mask].texture = NULL;
+		self->staleFrames++;
+	}
+
+	newest = self->slots[head & self->mask];
+	self->slots[head & self->mask].texture = NULL;
+
+	/* Hands the slots back to the producer. */
+	g_atomic_int_set(&self->head, (gint)tail);
+
+	sizeChanged = (self->current == NULL || gdk_texture_get_width(self->current) != gdk_texture_get_width(newest.texture) || gdk_texture_get_height(self->current) != gdk_texture_get_height(newest.texture));
+
+	g_clear_object(&self->current);
+	self->current = newest.texture;
+
+	self->presentedFrames++;
+	self->lastLatency = MAX(frameTime - newest.timestamp, 0);
+	self->totalLatency += self->lastLatency;
+	self->maxLatency = MAX(self->maxLatency, self->lastLatency);
+
+	if (sizeChanged)
+		gdk_paintable_invalidate_size(GDK_PAINTABLE(self));
+	gdk_paintable_invalidate_contents(GDK_PAINTABLE(self));
+}
+
+static void
+frameClockUpdate(GdkFrameClock* frameClock, gpointer userData)
+{
+	presentNewestFrame(userData, gdk_frame_clock_get_frame_time(frameClock));
+}
+
+static gboolean
+requestUpdate(gpointer userData)
+{
+	OGdkFrameQueuePaintableInstance* self = userData;
+
+	/* Frames pushed from now on schedule another wake-up. */
+	g_atomic_int_set(&self->wakePending, 0);
+
+	if (self->frameClock != NULL)
+		gdk_frame_clock_request_phase(self->frameClock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+stopPresenting(OGdkFrameQueuePaintableInstance* self)
+{
+	if (self->frameClock == NULL)
+		return;
+
+	g_signal_handler_disconnect(self->frameClock, self->updateHandlerID);
+	g_clear_object(&self->frameClock);
+}
+
+static void
+og_gdk_frame_queue_paintable_snapshot(GdkPaintable* paintable, GdkSnapshot* snapshot, double width, double height)
+{
+	OGdkFrameQueuePaintableInstance* self = (OGdkFrameQueuePaintableInstance*)paintable;
+
+	if (self->current != NULL)
+		gdk_paintable_snapshot(GDK_PAINTABLE(self->current), snapshot, width, height);
+}
+
+static GdkPaintable*
+og_gdk_frame_queue_paintable_get_current_image(GdkPaintable* paintable)
+{
+	OGdkFrameQueuePaintableInstance* self = (OGdkFrameQueuePaintableInstance*)paintable;
+
+	if (self->current != NULL)
+		return g_object_ref(GDK_PAINTABLE(self->current));
+
+	return gdk_paintable_new_empty(0, 0);
+}
+
+static int
+og_gdk_frame_queue_paintable_get_intrinsic_width(GdkPaintable* paintable)
+{
+	OGdkFrameQueuePaintableInstance* self = (OGdkFrameQueuePaintableInstance*)paintable;
+
+	return (self->current != NULL ? gdk_texture_get_width(self->current) : 0);
+}
+
+static int
+og_gdk_frame_queue_paintable_get_intrinsic_height(GdkPaintable* paintable)
+{
+	OGdkFrameQueuePaintableInstance* self = (OGdkFrameQueuePaintableInstance*)paintable;
+
+	return (self->current != NULL ? gdk_texture_get_height(self->current) : 0);
+}
+
+static void
+og_gdk_frame_queue_paintable_paintable_init(GdkPaintableInterface* iface)
+{
+	iface->snapshot = og_gdk_frame_queue_paintable_snapshot;
+	iface->get_current_image = og_gdk_frame_queue_paintable_get_current_image;
+	iface->get_intrinsic_width = og_gdk_frame_queue_paintable_get_intrinsic_width;
+	iface->get_intrinsic_height = og_gdk_frame_queue_paintable_get_intrinsic_height;
+}
+
+static void
+og_gdk_frame_queue_paintable_finalize(GObject* object)
+{
+	OGdkFrameQueuePaintableInstance* self = (OGdkFrameQueuePaintableInstance*)object;
+
+	stopPresenting(self);
+
+	for (guint i = (guint)self->head; i != (guint)self->tail; i++)
+		g_object_unref(self->slots[i & self->mask].texture);
+
+	g_free(self->slots);
+	g_clear_object(&self->current);
+	g_main_context_unref(self->mainContext);
+
+	G_OBJECT_CLASS(og_gdk_frame_queue_paintable_parent_class)->finalize(object);
+}
+
+static void
+og_gdk_frame_queue_paintable_class_init(OGdkFrameQueuePaintableInstanceClass* klass)
+{
+	G_OBJECT_CLASS(klass)->finalize = og_gdk_frame_queue_paintable_finalize;
+}
+
+static void
+og_gdk_frame_queue_paintable_init(OGdkFrameQueuePaintableInstance* self)
+{
+	self->mainContext = g_main_context_ref_thread_default();
+}
+
+@implementation OGdkFrameQueuePaintable
+
+static GTypeClass *gObjectClass = NULL;
+
++ (void)load
+{
+	GType gtypeToAssociate = OG_TYPE_GDK_FRAME_QUEUE_PAINTABLE;
+
+	if (gtypeToAssociate == 0)
+		return;
+
+	g_type_set_qdata(gtypeToAssociate, [super wrapperQuark], [self class]);
+}
+
++ (GTypeClass*)gObjectClass
+{
+	if(gObjectClass != NULL)
+		return gObjectClass;
+
+	gObjectClass = g_type_class_ref(OG_TYPE_GDK_FRAME_QUEUE_PAINTABLE);
+	return gObjectClass;
+}
+
++ (instancetype)frameQueuePaintableWithCapacity:(unsigned int)capacity
+{
+	OGdkFrameQueuePaintableInstance* instance;
+
+	if (capacity == 0)
+		capacity = OG_FRAME_QUEUE_DEFAULT_CAPACITY;
+
+	if (capacity > OG_FRAME_QUEUE_MAX_CAPACITY)
+		@throw [OFInvalidArgumentException exception];
+
+	GdkPaintable* gobjectValue = g_object_new(OG_TYPE_GDK_FRAME_QUEUE_PAINTABLE, NULL);
+
+	if OF_UNLIKELY(!gobjectValue)
+		@throw [OGObjectGObjectToWrapCreationFailedException exception];
+
+	/* A power of two, so that the indices may wrap around. */
+	instance = (OGdkFrameQueuePaintableInstance*)gobjectValue;
+	instance->mask = (1u << g_bit_storage(capacity - 1)) - 1;
+	instance->slots = g_new0(OGQueuedFrame, instance->mask + 1);
+
+	OGdkFrameQueuePaintable* wrapperObject;
+	@try {
+		wrapperObject = [[OGdkFrameQueuePaintable alloc] initWithGObject:gobjectValue];
+	} @catch (id e) {
+		g_object_unref(gobjectValue);
+		[wrapperObject release];
+		@throw e;
+	}
+
+	g_object_unref(gobjectValue);
+	return [wrapperObject autorelease];
+}
+
+- (GdkPaintable*)castedGObject
+{
+	return G_TYPE_CHECK_INSTANCE_CAST([self gObject], OG_TYPE_GDK_FRAME_QUEUE_PAINTABLE, GdkPaintable);
+}
+
+- (bool)pushTexture:(OGdkTexture*)texture timestamp:(gint64)timestamp
+{
+	OGdkFrameQueuePaintableInstance* instance = (OGdkFrameQueuePaintableInstance*)[self castedGObject];
+	guint tail = (guint)instance->tail;
+	guint head = (guint)g_atomic_int_get(&instance->head);
+	OGQueuedFrame* slot;
+
+	if (texture == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	if (tail - head > instance->mask) {
+		g_atomic_int_inc(&instance->rejectedFrames);
+		return false;
+	}
+
+	slot = &instance->slots[tail & instance->mask];
+	slot->texture = g_object_ref([texture castedGObject]);
+	slot->timestamp = (timestamp != 0 ? timestamp : g_get_monotonic_time());
+
+	/* Publishes the slot to the consumer. */
+	g_atomic_int_set(&instance->tail, (gint)(tail + 1));
+	g_atomic_int_inc(&instance->pushedFrames);
+
+	if (g_atomic_int_compare_and_exchange(&instance->wakePending, 0, 1))
+		g_main_context_invoke_full(instance->mainContext, G_PRIORITY_DEFAULT, requestUpdate, g_object_ref(instance), g_object_unref);
+
+	return true;
+}
+
+- (void)startWithFrameClock:(OGdkFrameClock*)frameClock
+{
+	OGdkFrameQueuePaintableInstance* instance = (OGdkFrameQueuePaintableInstance*)[self castedGObject];
+
+	if (frameClock == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	if (instance->frameClock == [frameClock castedGObject])
+		return;
+
+	stopPresenting(instance);
+
+	instance->frameClock = g_object_ref([frameClock castedGObject]);
+	instance->updateHandlerID = g_signal_connect(instance->frameClock, "update", G_CALLBACK(frameClockUpdate), instance);
+
+	/* Frames may have been queued while no frame clock was attached. */
+	if ((guint)g_atomic_int_get(&instance->tail) != (guint)instance->head)
+		gdk_frame_clock_request_phase(instance->frameClock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+}
+
+- (void)stop
+{
+	stopPresenting((OGdkFrameQueuePaintableInstance*)[self castedGObject]);
+}
+
+- (OGdkFrameQueueStatistics)statistics
+{
+	OGdkFrameQueuePaintableInstance* instance = (OGdkFrameQueuePaintableInstance*)[self castedGObject];
+	OGdkFrameQueueStatistics statistics;
+
+	statistics.pushedFrames = (guint)g_atomic_int_get(&instance->pushedFrames);
+	statistics.presentedFrames = instance->presentedFrames;
+	statistics.staleFrames = instance->staleFrames;
+	statistics.rejectedFrames = (guint)g_atomic_int_get(&instance->rejectedFrames);
+	statistics.lastLatency = instance->lastLatency;
+	statistics.averageLatency = (instance->presentedFrames > 0 ? instance->totalLatency / (gint64)instance->presentedFrames : 0);
+	statistics.maxLatency = instance->maxLatency;
+
+	return statistics;
+}
+
+- (void)resetStatistics
+{
+	OGdkFrameQueuePaintableInstance* instance = (OGdkFrameQueuePaintableInstance*)[self castedGObject];
+
+	g_atomic_int_set(&instance->pushedFrames, 0);
+	g_atomic_int_set(&instance->rejectedFrames, 0);
+	instance->presentedFrames = 0;
+	instance->staleFrames = 0;
+	instance->lastLatency = 0;
+	instance->totalLatency = 0;
+	instance->maxLatency = 0;
+}
+
+@end
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkFrameClock;
+
+/**
+ * The measurements kept by an `OGdkFrameStats`.
+ */
+typedef enum {
+	/** The duration of the update phase */
+	OGdkFrameStatsUpdate,
+	/** The duration of the layout phase */
+	OGdkFrameStatsLayout,
+	/** The duration of the paint phase */
+	OGdkFrameStatsPaint,
+	/** The duration from the end of before-paint to the end of after-paint */
+	OGdkFrameStatsFrame,
+	/** The time between the frame times of consecutive frames */
+	OGdkFrameStatsInterval
+} OGdkFrameStatsMeasurement;
+
+#define OG_FRAME_STATS_MEASUREMENT_COUNT 5
+
+/**
+ * Collects frame timing statistics of an `OGdkFrameClock`, e.g. to detect
+ * jank regressions in production builds.
+ *
+ * The monitor connects to the phase signals of the frame clock and measures
+ * each phase from the end of the previous one to its own end. Durations are
+ * recorded in microseconds into HDR histograms with a relative precision of
+ * about 3% up to about 134 seconds, longer durations are counted as that
+ * long. Percentiles can be queried at any time without keeping individual
+ * samples. The histograms use atomic counters
+ * and can be read from any thread while the frame clock keeps recording.
+ *
+ * A frame counts as missed when the interval to the previous frame exceeds
+ * 1.5 refresh intervals; every refresh interval skipped adds one missed
+ * frame. Intervals longer than a second are treated as idle time and not
+ * recorded, as the frame clock stops when nothing changes.
+ *
+ * The monitor must be created and stopped on the thread of the frame clock.
+ */
+@interface OGdkFrameStats : OFObject
+{
+	OGdkFrameClock* _frameClock;
+	gulong _signalHandlers[5];
+	struct OGdkFrameStatsState* _state;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)frameStatsWithFrameClock:(OGdkFrameClock*)frameClock;
+
+/**
+ * Initializes a monitor and starts recording.
+ *
+ * @param frameClock the frame clock to monitor, usually the one of a
+ *   toplevel widget
+ * @return an initialized frame statistics monitor
+ */
+- (instancetype)initWithFrameClock:(OGdkFrameClock*)frameClock;
+
+/**
+ * Methods
+ */
+
+/**
+ * Stops recording and disconnects from the frame clock. The statistics
+ * recorded so far stay available.
+ */
+- (void)stop;
+
+/**
+ * Returns a percentile of a measurement.
+ *
+ * @param percentile the percentile, between 0 and 100
+ * @param measurement the measurement
+ * @return the value in microseconds, or 0 if nothing was recorded
+ */
+- (gint64)percentile:(double)percentile ofMeasurement:(OGdkFrameStatsMeasurement)measurement;
+
+/**
+ * The highest value recorded for a measurement.
+ *
+ * @param measurement the measurement
+ * @return the value in microseconds, or 0 if nothing was recorded
+ */
+- (gint64)maximumOfMeasurement:(OGdkFrameStatsMeasurement)measurement;
+
+/**
+ * The number of values recorded for a measurement.
+ *
+ * @param measurement the measurement
+ * @return the number of values
+ */
+- (guint64)countOfMeasurement:(OGdkFrameStatsMeasurement)measurement;
+
+/**
+ * The number of frames painted.
+ *
+ * @return the number of frames
+ */
+- (guint64)frameCount;
+
+/**
+ * The number of frames missed according to the refresh interval.
+ *
+ * @return the number of missed frames
+ */
+- (guint64)missedFrameCount;
+
+/**
+ * Returns the statistics as a JSON object, with the frame and missed frame
+ * counts and, for each measurement, the count, p50, p95, p99 and maximum
+ * in microseconds.
+ *
+ * @return the statistics in JSON
+ */
+- (OFString*)JSONRepresentation;
+
+/**
+ * Discards all recorded values.
+ */
+- (void)reset;
+
+@end
@@ -0,0 +1,321 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <math.h>
+
+#import "OGdkFrameStats.h"
+
+#import "OGdkFrameClock.h"
+
+/*
+ * Log-linear buckets: values below 64 µs get a bucket each, above that
+ * every power of two is split into 32 buckets, up to 2^27 µs.
+ */
+#define OG_HISTOGRAM_SUB_BUCKET_BITS 5
+#define OG_HISTOGRAM_SUB_BUCKETS (1 << OG_HISTOGRAM_SUB_BUCKET_BITS)
+#define OG_HISTOGRAM_MAX_BIT 26
+#define OG_HISTOGRAM_BUCKETS (2 * OG_HISTOGRAM_SUB_BUCKETS + (OG_HISTOGRAM_MAX_BIT - OG_HISTOGRAM_SUB_BUCKET_BITS) * OG_HISTOGRAM_SUB_BUCKETS)
+
+/* Intervals above this are idle time of the frame clock, not frames. */
+#define OG_FRAME_STATS_IDLE_INTERVAL G_USEC_PER_SEC
+#define OG_FRAME_STATS_DEFAULT_REFRESH_INTERVAL 16667
+
+typedef struct {
+	gint buckets[OG_HISTOGRAM_BUCKETS];
+	gint count;
+	gint maximum;
+} OGHistogram;
+
+struct OGdkFrameStatsState {
+	OGHistogram histograms[OG_FRAME_STATS_MEASUREMENT_COUNT];
+	gint frameCount;
+	gint missedFrameCount;
+	/* Only touched by the signal handlers on the frame clock thread. */
+	gint64 frameStart;
+	gint64 lastPhaseEnd;
+	gint64 lastFrameTime;
+};
+
+static const char* const measurementNames[OG_FRAME_STATS_MEASUREMENT_COUNT] = { "update", "layout", "paint", "frame", "interval" };
+
+static unsigned int
+bucketForValue(gint64 value)
+{
+	unsigned int bit, shift;
+
+	/* Longer durations are counted in the last bucket. */
+	value = CLAMP(value, 0, ((gint64)1 << (OG_HISTOGRAM_MAX_BIT + 1)) - 1);
+
+	if (value < 2 * OG_HISTOGRAM_SUB_BUCKETS)
+		return (unsigned int)value;
+
+	bit = (unsigned int)g_bit_nth_msf((gulong)value, -1);
+	shift = bit - OG_HISTOGRAM_SUB_BUCKET_BITS;
+
+	return 2 * OG_HISTOGRAM_SUB_BUCKETS + (shift - 1) * OG_HISTOGRAM_SUB_BUCKETS + (unsigned int)((value >> shift) - OG_HISTOGRAM_SUB_BUCKETS);
+}
+
+/* The middle of the values falling into a bucket. */
+static gint64
+valueForBucket(unsigned int bucket)
+{
+	unsigned int shift;
+	gint64 lowest;
+
+	if (bucket < 2 * OG_HISTOGRAM_SUB_BUCKETS)
+		return bucket;
+
+	shift = (bucket - 2 * OG_HISTOGRAM_SUB_BUCKETS) / OG_HISTOGRAM_SUB_BUCKETS + 1;
+	lowest = (gint64)((bucket - 2 * OG_HISTOGRAM_SUB_BUCKETS) % OG_HISTOGRAM_SUB_BUCKETS + OG_HISTOGRAM_SUB_BUCKETS) << shift;
+
+	return lowest + (((gint64)1 << shift) >> 1);
+}
+
+static void
+recordValue(OGHistogram* histogram, gint64 value)
+{
+	gint clamped = (gint)MIN(MAX(value, 0), G_MAXINT);
+	gint maximum;
+
+	g_atomic_int_inc(&histogram->buckets[bucketForValue(value)]);
+	g_atomic_int_inc(&histogram->count);
+
+	do {
+		maximum = g_atomic_int_get(&histogram->maximum);
+	} while (clamped > maximum && !g_atomic_int_compare_and_exchange(&histogram->maximum, maximum, clamped));
+}
+
+static gint64
+histogramPercentile(OGHistogram* histogram, double percentile)
+{
+	gint64 count = g_atomic_int_get(&histogram->count);
+	gint64 target, seen = 0;
+
+	if (count == 0)
+		return 0;
+
+	target = MAX((gint64)ceil(percentile / 100 * count), 1);
+
+	for (unsigned int i = 0; i < OG_HISTOGRAM_BUCKETS; i++) {
+		seen += g_atomic_int_get(&histogram->buckets[i]);
+
+		if (seen >= target)
+			return MIN(valueForBucket(i), g_atomic_int_get(&histogram->maximum));
+	}
+
+	return g_atomic_int_get(&histogram->maximum);
+}
+
+static void
+recordPhase(struct OGdkFrameStatsState* state, OGdkFrameStatsMeasurement measurement)
+{
+	gint64 now = g_get_monotonic_time();
+
+	if (state->frameStart == 0)
+		return;
+
+	recordValue(&state->histograms[measurement], now - state->lastPhaseEnd);
+	state->lastPhaseEnd = now;
+}
+
+static void
+beforePaint(GdkFrameClock* frameClock, gpointer userData)
+{
+	struct OGdkFrameStatsState* state = userData;
+
+	state->frameStart = state->lastPhaseEnd = g_get_monotonic_time();
+}
+
+static void
+update(GdkFrameClock* frameClock, gpointer userData)
+{
+	recordPhase(userData, OGdkFrameStatsUpdate);
+}
+
+static void
+layout(GdkFrameClock* frameClock, gpointer userData)
+{
+	recordPhase(userData, OGdkFrameStatsLayout);
+}
+
+static void
+paint(GdkFrameClock* frameClock, gpointer userData)
+{
+	recordPhase(userData, OGdkFrameStatsPaint);
+}
+
+static void
+afterPaint(GdkFrameClock* frameClock, gpointer userData)
+{
+	struct OGdkFrameStatsState* state = userData;
+	gint64 frameTime = gdk_frame_clock_get_frame_time(frameClock);
+
+	if (state->frameStart == 0)
+		return;
+
+	recordValue(&state->histograms[OGdkFrameStatsFrame], g_get_monotonic_time() - state->frameStart);
+	g_atomic_int_inc(&state->frameCount);
+	state->frameStart = 0;
+
+	if (state->lastFrameTime != 0) {
+		gint64 interval = frameTime - state->lastFrameTime;
+		gint64 refreshInterval = 0;
+
+		if (interval > 0 && interval <= OG_FRAME_STATS_IDLE_INTERVAL) {
+			recordValue(&state->histograms[OGdkFrameStatsInterval], interval);
+
+			gdk_frame_clock_get_refresh_info(frameClock, frameTime, &refreshInterval, NULL);
+			if (refreshInterval <= 0)
+				refreshInterval = OG_FRAME_STATS_DEFAULT_REFRESH_INTERVAL;
+
+			if (interval * 2 > refreshInterval * 3)
+				g_atomic_int_add(&state->missedFrameCount, (gint)((interval + refreshInterval / 2) / refreshInterval - 1));
+		}
+	}
+
+	state->lastFrameTime = frameTime;
+}
+
+@implementation OGdkFrameStats
+
++ (instancetype)frameStatsWithFrameClock:(OGdkFrameClock*)frameClock
+{
+	return [[[self alloc] initWithFrameClock:frameClock] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithFrameClock:(OGdkFrameClock*)frameClock
+{
+	self = [super init];
+
+	@try {
+		GdkFrameClock* clock;
+
+		if (frameClock == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		_frameClock = [frameClock retain];
+		_state = g_new0(struct OGdkFrameStatsState, 1);
+
+		/* Connected after, so each timestamp is taken once the phase has run. */
+		clock = [frameClock castedGObject];
+		_signalHandlers[0] = g_signal_connect_after(clock, "before-paint", G_CALLBACK(beforePaint), _state);
+		_signalHandlers[1] = g_signal_connect_after(clock, "update", G_CALLBACK(update), _state);
+		_signalHandlers[2] = g_signal_connect_after(clock, "layout", G_CALLBACK(layout), _state);
+		_signalHandlers[3] = g_signal_connect_after(clock, "paint", G_CALLBACK(paint), _state);
+		_signalHandlers[4] = g_signal_connect_after(clock, "after-paint", G_CALLBACK(afterPaint), _state);
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[self stop];
+
+	g_free(_state);
+
+	[super dealloc];
+}
+
+- (void)stop
+{
+	if (_frameClock == nil)
+		return;
+
+	for (size_t i = 0; i < sizeof(_signalHandlers) / sizeof(*_signalHandlers); i++)
+		g_signal_handler_disconnect([_frameClock castedGObject], _signalHandlers[i]);
+
+	[_frameClock release];
+	_frameClock = nil;
+}
+
+- (gint64)percentile:(double)percentile ofMeasurement:(OGdkFrameStatsMeasurement)measurement
+{
+	if (measurement >= OG_FRAME_STATS_MEASUREMENT_COUNT || percentile < 0 || percentile > 100)
+		@throw [OFInvalidArgumentException exception];
+
+	return histogramPercentile(&_state->histograms[measurement], percentile);
+}
+
+- (gint64)maximumOfMeasurement:(OGdkFrameStatsMeasurement)measurement
+{
+	if (measurement >= OG_FRAME_STATS_MEASUREMENT_COUNT)
+		@throw [OFInvalidArgumentException exception];
+
+	return g_atomic_int_get(&_state->histograms[measurement].maximum);
+}
+
+- (guint64)countOfMeasurement:(OGdkFrameStatsMeasurement)measurement
+{
+	if (measurement >= OG_FRAME_STATS_MEASUREMENT_COUNT)
+		@throw [OFInvalidArgumentException exception];
+
+	return (guint64)g_atomic_int_get(&_state->histograms[measurement].count);
+}
+
+- (guint64)frameCount
+{
+	return (guint64)g_atomic_int_get(&_state->frameCount);
+}
+
+- (guint64)missedFrameCount
+{
+	return (guint64)g_atomic_int_get(&_state->missedFrameCount);
+}
+
+- (OFString*)JSONRepresentation
+{
+	void* pool = objc_autoreleasePoolPush();
+	OFMutableDictionary* dictionary = [OFMutableDictionary dictionary];
+	OFString* JSON;
+
+	[dictionary setObject:[OFNumber numberWithUnsignedLongLong:[self frameCount]] forKey:@"frames"];
+	[dictionary setObject:[OFNumber numberWithUnsignedLongLong:[self missedFrameCount]] forKey:@"missedFrames"];
+
+	for (int i = 0; i < OG_FRAME_STATS_MEASUREMENT_COUNT; i++) {
+		OGHistogram* histogram = &_state->histograms[i];
+		OFDictionary* measurement = [OFDictionary dictionaryWithKeysAndObjects:
+		    @"count", [OFNumber numberWithInt:g_atomic_int_get(&histogram->count)],
+		    @"p50", [OFNumber numberWithLongLong:histogramPercentile(histogram, 50)],
+		    @"p95", [OFNumber numberWithLongLong:histogramPercentile(histogram, 95)],
+		    @"p99", [OFNumber numberWithLongLong:histogramPercentile(histogram, 99)],
+		    @"max", [OFNumber numberWithInt:g_atomic_int_get(&histogram->maximum)],
+		    nil];
+
+		[dictionary setObject:measurement forKey:[OFString stringWithUTF8String:measurementNames[i]]];
+	}
+
+	JSON = [[dictionary JSONRepresentation] retain];
+
+	objc_autoreleasePoolPop(pool);
+
+	return [JSON autorelease];
+}
+
+- (void)reset
+{
+	for (int i = 0; i < OG_FRAME_STATS_MEASUREMENT_COUNT; i++) {
+		OGHistogram* histogram = &_state->histograms[i];
+
+		for (unsigned int j = 0; j < OG_HISTOGRAM_BUCKETS; j++)
+			g_atomic_int_set(&histogram->buckets[j], 0);
+
+		g_atomic_int_set(&histogram->count, 0);
+		g_atomic_int_set(&histogram->maximum, 0);
+	}
+
+	g_atomic_int_set(&_state->frameCount, 0);
+	g_atomic_int_set(&_state->missedFrameCount, 0);
+}
+
+@end
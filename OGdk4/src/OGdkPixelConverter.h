@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkMemoryTexture;
+@class OGdkPixbuf;
+
+/**
+ * `OGdkPixelConverter` converts pixel data between the memory formats used by
+ * cameras, decoders and `GdkMemoryTexture`.
+ *
+ * Supported source formats are %GDK_MEMORY_R8G8B8, %GDK_MEMORY_B8G8R8,
+ * %GDK_MEMORY_R8G8B8A8, %GDK_MEMORY_B8G8R8A8, their premultiplied variants,
+ * %GDK_MEMORY_R16G16B16, %GDK_MEMORY_R16G16B16A16 and
+ * %GDK_MEMORY_R16G16B16A16_PREMULTIPLIED. Supported destination formats are
+ * all of the 8 bit formats above.
+ *
+ * Channel swizzling, RGB expansion, premultiplication and the 16 to 8 bit
+ * conversion use SSE2, SSSE3 or AVX2 on x86 and NEON on ARM, selected at
+ * runtime. All code paths produce bit-identical results: premultiplication
+ * and narrowing round to nearest.
+ */
+@interface OGdkPixelConverter : OFObject
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
+
+/**
+ * Returns whether pixels can be converted between the specified formats.
+ *
+ * @param sourceFormat the format of the source pixels
+ * @param destinationFormat the format of the destination pixels
+ * @return whether the conversion is supported
+ */
++ (bool)canConvertFromFormat:(GdkMemoryFormat)sourceFormat toFormat:(GdkMemoryFormat)destinationFormat;
+
+/**
+ * Converts pixels from one format into another.
+ *
+ * Source and destination may be the same buffer if both formats use the
+ * same number of bytes per pixel and the strides are equal.
+ *
+ * @param source the source pixels
+ * @param sourceFormat the format of the source pixels
+ * @param sourceStride the distance between two source rows in bytes
+ * @param destination the destination pixels
+ * @param destinationFormat the format of the destination pixels
+ * @param destinationStride the distance between two destination rows in bytes
+ * @param width the width in pixels
+ * @param height the height in pixels
+ */
++ (void)convertPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride toPixels:(void*)destination format:(GdkMemoryFormat)destinationFormat stride:(size_t)destinationStride width:(int)width height:(int)height;
+
+/**
+ * Converts pixels into a newly allocated, tightly packed `GBytes`.
+ *
+ * @param source the source pixels
+ * @param sourceFormat the format of the source pixels
+ * @param sourceStride the distance between two source rows in bytes
+ * @param destinationFormat the format of the destination pixels
+ * @param width the width in pixels
+ * @param height the height in pixels
+ * @param destinationStride location to store the stride of the returned
+ *   pixels, or %NULL
+ * @return the converted pixels, to be released with g_bytes_unref()
+ */
++ (GBytes*)bytesByConvertingPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride toFormat:(GdkMemoryFormat)destinationFormat width:(int)width height:(int)height destinationStride:(size_t*)destinationStride;
+
+/**
+ * Creates a memory texture by converting pixels directly into the buffer
+ * that backs the texture, without any intermediate copy.
+ *
+ * @param source the source pixels
+ * @param sourceFormat the format of the source pixels
+ * @param sourceStride the distance between two source rows in bytes
+ * @param width the width in pixels
+ * @param height the height in pixels
+ * @param textureFormat the format of the texture
+ * @return a new memory texture
+ */
++ (OGdkMemoryTexture*)memoryTextureWithPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride width:(int)width height:(int)height textureFormat:(GdkMemoryFormat)textureFormat;
+
+/**
+ * Creates a memory texture from the pixels of an 8 bit RGB or RGBA pixbuf.
+ *
+ * Converting to %GDK_MEMORY_B8G8R8A8_PREMULTIPLIED or
+ * %GDK_MEMORY_R8G8B8A8_PREMULTIPLIED up front avoids a later conversion
+ * by the renderer.
+ *
+ * @param pixbuf the pixbuf
+ * @param textureFormat the format of the texture
+ * @return a new memory texture
+ */
++ (OGdkMemoryTexture*)memoryTextureWithPixbuf:(OGdkPixbuf*)pixbuf textureFormat:(GdkMemoryFormat)textureFormat;
+
+/**
+ * The name of the instruction set the conversion kernels were selected for,
+ * one of "avx2", "ssse3", "sse2", "neon" or "scalar".
+ *
+ * @return the name of the selected implementation
+ */
++ (OFString*)implementationName;
+
+@end
@@ -0,0 +1,647 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#import "OGdkPixelConverter.h"
+
+#import <OGdkPixbuf/OGdkPixbuf.h>
+#import "OGdkMemoryTexture.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define OG_PIXEL_X86
+# include <immintrin.h>
+#elif defined(__ARM_NEON)
+# define OG_PIXEL_NEON
+# include <arm_neon.h>
+#endif
+
+/*
+ * Row kernels. All 4 channel kernels expect the alpha channel last and work
+ * in place, as every block is loaded before it is stored.
+ */
+typedef void (*OGSwapRowFunc)(const uint8_t* src, uint8_t* dst, size_t n);
+typedef void (*OGExpandRowFunc)(const uint8_t* src, uint8_t* dst, size_t n, bool swap);
+typedef void (*OGPremultiplyRowFunc)(const uint8_t* src, uint8_t* dst, size_t n);
+typedef void (*OGNarrowFunc)(const uint16_t* src, uint8_t* dst, size_t count);
+
+static uint8_t unpremultiplyTable[256][256];
+
+static struct {
+	const char* name;
+	OGSwapRowFunc swap;
+	OGExpandRowFunc expand;
+	OGPremultiplyRowFunc premultiply;
+	OGNarrowFunc narrow;
+} kernels;
+
+static inline uint8_t
+multiplyAlpha(uint8_t c, uint8_t a)
+{
+	unsigned int t = c * a + 128;
+
+	return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+/* Rounds v / 257 to nearest, see narrowScalar(). */
+static inline uint8_t
+narrowValue(uint16_t v)
+{
+	int q = v >> 8, d = (v & 0xFF) - q;
+
+	return (uint8_t)(q + (d > 128) - (d < -128));
+}
+
+static void
+swapRowScalar(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++, src += 4, dst += 4) {
+		uint8_t r = src[0], g = src[1], b = src[2], a = src[3];
+
+		dst[0] = b;
+		dst[1] = g;
+		dst[2] = r;
+		dst[3] = a;
+	}
+}
+
+static void
+expandRowScalar(const uint8_t* src, uint8_t* dst, size_t n, bool swap)
+{
+	int first = (swap ? 2 : 0), last = (swap ? 0 : 2);
+
+	for (size_t i = 0; i < n; i++, src += 3, dst += 4) {
+		dst[0] = src[first];
+		dst[1] = src[1];
+		dst[2] = src[last];
+		dst[3] = 0xFF;
+	}
+}
+
+static void
+premultiplyRowScalar(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++, src += 4, dst += 4) {
+		uint8_t a = src[3];
+
+		dst[0] = multiplyAlpha(src[0], a);
+		dst[1] = multiplyAlpha(src[1], a);
+		dst[2] = multiplyAlpha(src[2], a);
+		dst[3] = a;
+	}
+}
+
+/*
+ * v = 256q + r = 257q + (r - q), so v / 257 rounds to q + 1 if r - q > 128
+ * and to q - 1 if r - q < -128. This only needs 16 bit arithmetic, which
+ * keeps the vector variants exact.
+ */
+static void
+narrowScalar(const uint16_t* src, uint8_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		dst[i] = narrowValue(src[i]);
+}
+
+static void
+unpremultiplyRow(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++, src += 4, dst += 4) {
+		const uint8_t* table = unpremultiplyTable[src[3]];
+		uint8_t a = src[3];
+
+		dst[0] = table[src[0]];
+		dst[1] = table[src[1]];
+		dst[2] = table[src[2]];
+		dst[3] = a;
+	}
+}
+
+static void
+swapRow3(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++, src += 3, dst += 3) {
+		uint8_t r = src[0], g = src[1], b = src[2];
+
+		dst[0] = b;
+		dst[1] = g;
+		dst[2] = r;
+	}
+}
+
+static void
+dropAlphaRow(const uint8_t* src, uint8_t* dst, size_t n, bool swap)
+{
+	int first = (swap ? 2 : 0), last = (swap ? 0 : 2);
+
+	for (size_t i = 0; i < n; i++, src += 4, dst += 3) {
+		dst[0] = src[first];
+		dst[1] = src[1];
+		dst[2] = src[last];
+	}
+}
+
+#ifdef OG_PIXEL_X86
+__attribute__((__target__("sse2"))) static void
+swapRowSSE2(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	const __m128i greenAlpha = _mm_set1_epi32((int)0xFF00FF00);
+	size_t i = 0;
+
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		__m128i redBlue = _mm_andnot_si128(greenAlpha, v);
+
+		redBlue = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+		v = _mm_or_si128(_mm_and_si128(v, greenAlpha), redBlue);
+		_mm_storeu_si128((__m128i*)(dst + i * 4), v);
+	}
+
+	swapRowScalar(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((__target__("sse2"))) static void
+premultiplyRowSSE2(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i half = _mm_set1_epi16(128);
+	const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+	size_t i = 0;
+
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		__m128i halves[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+
+		for (int j = 0; j < 2; j++) {
+			__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[j], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i t = _mm_add_epi16(_mm_mullo_epi16(halves[j], alpha), half);
+
+			t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+			halves[j] = _mm_or_si128(_mm_andnot_si128(alphaLanes, t), _mm_and_si128(alphaLanes, halves[j]));
+		}
+
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+	}
+
+	premultiplyRowScalar(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((__target__("sse2"))) static __m128i
+narrowVectorSSE2(__m128i v)
+{
+	__m128i q = _mm_srli_epi16(v, 8);
+	__m128i d = _mm_sub_epi16(_mm_and_si128(v, _mm_set1_epi16(0xFF)), q);
+
+	/* The comparison masks are -1 where true. */
+	q = _mm_sub_epi16(q, _mm_cmpgt_epi16(d, _mm_set1_epi16(128)));
+	q = _mm_add_epi16(q, _mm_cmplt_epi16(d, _mm_set1_epi16(-128)));
+
+	return q;
+}
+
+__attribute__((__target__("sse2"))) static void
+narrowSSE2(const uint16_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i lo = narrowVectorSSE2(_mm_loadu_si128((const __m128i*)(src + i)));
+		__m128i hi = narrowVectorSSE2(_mm_loadu_si128((const __m128i*)(src + i + 8)));
+
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+
+	narrowScalar(src + i, dst + i, count - i);
+}
+
+__attribute__((__target__("ssse3"))) static void
+swapRowSSSE3(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	size_t i = 0;
+
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(v, mask));
+	}
+
+	swapRowScalar(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((__target__("ssse3"))) static void
+expandRowSSSE3(const uint8_t* src, uint8_t* dst, size_t n, bool swap)
+{
+	const __m128i mask = (swap
+	    ? _mm_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128)
+	    : _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128));
+	const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+	size_t i = 0;
+
+	/* Every load reads 16 bytes but only uses 12, don't read past the row. */
+	for (; i + 6 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 3));
+
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+	}
+
+	expandRowScalar(src + i * 3, dst + i * 4, n - i, swap);
+}
+
+__attribute__((__target__("avx2"))) static void
+swapRowAVX2(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	const __m256i mask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	size_t i = 0;
+
+	for (; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(v, mask));
+	}
+
+	swapRowSSSE3(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((__target__("avx2"))) static void
+premultiplyRowAVX2(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i half = _mm256_set1_epi16(128);
+	const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+	size_t i = 0;
+
+	for (; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+		__m256i halves[2] = { _mm256_unpacklo_epi8(v, zero), _mm256_unpackhi_epi8(v, zero) };
+
+		for (int j = 0; j < 2; j++) {
+			__m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(halves[j], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m256i t = _mm256_add_epi16(_mm256_mullo_epi16(halves[j], alpha), half);
+
+			t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+			halves[j] = _mm256_blendv_epi8(t, halves[j], alphaLanes);
+		}
+
+		/* Unpacking and packing both work per 128 bit lane. */
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_packus_epi16(halves[0], halves[1]));
+	}
+
+	premultiplyRowSSE2(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((__target__("avx2"))) static __m256i
+narrowVectorAVX2(__m256i v)
+{
+	__m256i q = _mm256_srli_epi16(v, 8);
+	__m256i d = _mm256_sub_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0xFF)), q);
+
+	q = _mm256_sub_epi16(q, _mm256_cmpgt_epi16(d, _mm256_set1_epi16(128)));
+	q = _mm256_add_epi16(q, _mm256_cmpgt_epi16(_mm256_set1_epi16(-128), d));
+
+	return q;
+}
+
+__attribute__((__target__("avx2"))) static void
+narrowAVX2(const uint16_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 32 <= count; i += 32) {
+		__m256i lo = narrowVectorAVX2(_mm256_loadu_si256((const __m256i*)(src + i)));
+		__m256i hi = narrowVectorAVX2(_mm256_loadu_si256((const __m256i*)(src + i + 16)));
+		__m256i packed = _mm256_packus_epi16(lo, hi);
+
+		/* Packing interleaves the 128 bit lanes of both inputs. */
+		packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+		_mm256_storeu_si256((__m256i*)(dst + i), packed);
+	}
+
+	narrowSSE2(src + i, dst + i, count - i);
+}
+#endif
+
+#ifdef OG_PIXEL_NEON
+static void
+swapRowNEON(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16) {
+		uint8x16x4_t v = vld4q_u8(src + i * 4);
+		uint8x16_t red = v.val[0];
+
+		v.val[0] = v.val[2];
+		v.val[2] = red;
+		vst4q_u8(dst + i * 4, v);
+	}
+
+	swapRowScalar(src + i * 4, dst + i * 4, n - i);
+}
+
+static void
+expandRowNEON(const uint8_t* src, uint8_t* dst, size_t n, bool swap)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16) {
+		uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+		uint8x16x4_t rgba;
+
+		rgba.val[0] = rgb.val[swap ? 2 : 0];
+		rgba.val[1] = rgb.val[1];
+		rgba.val[2] = rgb.val[swap ? 0 : 2];
+		rgba.val[3] = vdupq_n_u8(0xFF);
+		vst4q_u8(dst + i * 4, rgba);
+	}
+
+	expandRowScalar(src + i * 3, dst + i * 4, n - i, swap);
+}
+
+static inline uint8x8_t
+multiplyAlphaNEON(uint8x8_t c, uint8x8_t a)
+{
+	uint16x8_t t = vmull_u8(c, a);
+
+	/* ((t + 128) + ((t + 128) >> 8)) >> 8, like multiplyAlpha(). */
+	return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+
+static void
+premultiplyRowNEON(const uint8_t* src, uint8_t* dst, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= n; i += 8) {
+		uint8x8x4_t v = vld4_u8(src + i * 4);
+
+		v.val[0] = multiplyAlphaNEON(v.val[0], v.val[3]);
+		v.val[1] = multiplyAlphaNEON(v.val[1], v.val[3]);
+		v.val[2] = multiplyAlphaNEON(v.val[2], v.val[3]);
+		vst4_u8(dst + i * 4, v);
+	}
+
+	premultiplyRowScalar(src + i * 4, dst + i * 4, n - i);
+}
+
+static void
+narrowNEON(const uint16_t* src, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		uint16x8_t v = vld1q_u16(src + i);
+		int16x8_t q = vreinterpretq_s16_u16(vshrq_n_u16(v, 8));
+		int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vandq_u16(v, vdupq_n_u16(0xFF))), q);
+
+		/* The comparison masks are all ones, i.e. -1, where true. */
+		q = vsubq_s16(q, vreinterpretq_s16_u16(vcgtq_s16(d, vdupq_n_s16(128))));
+		q = vaddq_s16(q, vreinterpretq_s16_u16(vcltq_s16(d, vdupq_n_s16(-128))));
+		vst1_u8(dst + i, vmovn_u16(vreinterpretq_u16_s16(q)));
+	}
+
+	narrowScalar(src + i, dst + i, count - i);
+}
+#endif
+
+static gpointer
+selectKernels(gpointer data)
+{
+	for (unsigned int a = 1; a < 256; a++)
+		for (unsigned int c = 0; c < 256; c++)
+			unpremultiplyTable[a][c] = (uint8_t)MIN(255, (c * 255 + a / 2) / a);
+
+	kernels.name = "scalar";
+	kernels.swap = swapRowScalar;
+	kernels.expand = expandRowScalar;
+	kernels.premultiply = premultiplyRowScalar;
+	kernels.narrow = narrowScalar;
+
+#if defined(OG_PIXEL_X86)
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		kernels.name = "sse2";
+		kernels.swap = swapRowSSE2;
+		kernels.premultiply = premultiplyRowSSE2;
+		kernels.narrow = narrowSSE2;
+	}
+
+	if (__builtin_cpu_supports("ssse3")) {
+		kernels.name = "ssse3";
+		kernels.swap = swapRowSSSE3;
+		kernels.expand = expandRowSSSE3;
+	}
+
+	if (__builtin_cpu_supports("avx2")) {
+		kernels.name = "avx2";
+		kernels.swap = swapRowAVX2;
+		kernels.premultiply = premultiplyRowAVX2;
+		kernels.narrow = narrowAVX2;
+	}
+#elif defined(OG_PIXEL_NEON)
+	kernels.name = "neon";
+	kernels.swap = swapRowNEON;
+	kernels.expand = expandRowNEON;
+	kernels.premultiply = premultiplyRowNEON;
+	kernels.narrow = narrowNEON;
+#endif
+
+	return NULL;
+}
+
+static void
+ensureKernels(void)
+{
+	static GOnce once = G_ONCE_INIT;
+
+	g_once(&once, selectKernels, NULL);
+}
+
+typedef struct {
+	GdkMemoryFormat format;
+	unsigned int channels;
+	bool bgr;
+	bool premultiplied;
+	bool wide;
+} OGPixelFormatInfo;
+
+static const OGPixelFormatInfo formatInfos[] = {
+	{ GDK_MEMORY_R8G8B8, 3, false, false, false },
+	{ GDK_MEMORY_B8G8R8, 3, true, false, false },
+	{ GDK_MEMORY_R8G8B8A8, 4, false, false, false },
+	{ GDK_MEMORY_B8G8R8A8, 4, true, false, false },
+	{ GDK_MEMORY_R8G8B8A8_PREMULTIPLIED, 4, false, true, false },
+	{ GDK_MEMORY_B8G8R8A8_PREMULTIPLIED, 4, true, true, false },
+	{ GDK_MEMORY_R16G16B16, 3, false, false, true },
+	{ GDK_MEMORY_R16G16B16A16, 4, false, false, true },
+	{ GDK_MEMORY_R16G16B16A16_PREMULTIPLIED, 4, false, true, true }
+};
+
+static const OGPixelFormatInfo*
+formatInfo(GdkMemoryFormat format)
+{
+	for (size_t i = 0; i < sizeof(formatInfos) / sizeof(*formatInfos); i++)
+		if (formatInfos[i].format == format)
+			return &formatInfos[i];
+
+	return NULL;
+}
+
+static size_t
+bytesPerPixel(const OGPixelFormatInfo* info)
+{
+	return info->channels * (info->wide ? 2 : 1);
+}
+
+/*
+ * Converts one row. scratch must hold width * 4 bytes and may only alias src
+ * if the source is 16 bit, in which case it is narrowed into scratch first.
+ */
+static void
+convertRow(const OGPixelFormatInfo* srcInfo, const OGPixelFormatInfo* dstInfo, const uint8_t* src, uint8_t* dst, uint8_t* scratch, size_t width)
+{
+	bool swap = (srcInfo->bgr != dstInfo->bgr);
+
+	if (srcInfo->wide) {
+		kernels.narrow((const uint16_t*)src, scratch, width * srcInfo->channels);
+		src = scratch;
+	}
+
+	if (srcInfo->channels == 3 && dstInfo->channels == 3) {
+		if (swap)
+			swapRow3(src, dst, width);
+		else if (src != dst)
+			memmove(dst, src, width * 3);
+	} else if (srcInfo->channels == 3) {
+		/* Opaque pixels are the same premultiplied or not. */
+		kernels.expand(src, dst, width, swap);
+	} else if (dstInfo->channels == 3) {
+		if (srcInfo->premultiplied) {
+			unpremultiplyRow(src, scratch, width);
+			src = scratch;
+		}
+
+		dropAlphaRow(src, dst, width, swap);
+	} else if (srcInfo->premultiplied == dstInfo->premultiplied) {
+		if (swap)
+			kernels.swap(src, dst, width);
+		else if (src != dst)
+			memmove(dst, src, width * 4);
+	} else if (dstInfo->premultiplied) {
+		if (swap) {
+			kernels.swap(src, dst, width);
+			src = dst;
+		}
+
+		kernels.premultiply(src, dst, width);
+	} else {
+		unpremultiplyRow(src, dst, width);
+
+		if (swap)
+			kernels.swap(dst, dst, width);
+	}
+}
+
+@implementation OGdkPixelConverter
+
++ (bool)canConvertFromFormat:(GdkMemoryFormat)sourceFormat toFormat:(GdkMemoryFormat)destinationFormat
+{
+	const OGPixelFormatInfo* dstInfo = formatInfo(destinationFormat);
+
+	return (formatInfo(sourceFormat) != NULL && dstInfo != NULL && !dstInfo->wide);
+}
+
++ (void)convertPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride toPixels:(void*)destination format:(GdkMemoryFormat)destinationFormat stride:(size_t)destinationStride width:(int)width height:(int)height
+{
+	const OGPixelFormatInfo* srcInfo = formatInfo(sourceFormat);
+	const OGPixelFormatInfo* dstInfo = formatInfo(destinationFormat);
+	uint8_t* scratch;
+
+	if (srcInfo == NULL || dstInfo == NULL || dstInfo->wide)
+		@throw [OFInvalidArgumentException exception];
+
+	if (source == NULL || destination == NULL || width < 0 || height < 0)
+		@throw [OFInvalidArgumentException exception];
+
+	if (sourceStride < width * bytesPerPixel(srcInfo) || destinationStride < width * bytesPerPixel(dstInfo))
+		@throw [OFInvalidArgumentException exception];
+
+	if (source == destination && (bytesPerPixel(srcInfo) != bytesPerPixel(dstInfo) || sourceStride != destinationStride))
+		@throw [OFInvalidArgumentException exception];
+
+	if (width == 0 || height == 0)
+		return;
+
+	ensureKernels();
+
+	scratch = OFAllocMemory(width, 4);
+	for (int y = 0; y < height; y++)
+		convertRow(srcInfo, dstInfo, (const uint8_t*)source + y * sourceStride, (uint8_t*)destination + y * destinationStride, scratch, (size_t)width);
+	OFFreeMemory(scratch);
+}
+
++ (GBytes*)bytesByConvertingPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride toFormat:(GdkMemoryFormat)destinationFormat width:(int)width height:(int)height destinationStride:(size_t*)destinationStride
+{
+	const OGPixelFormatInfo* dstInfo = formatInfo(destinationFormat);
+	size_t stride;
+	guchar* pixels;
+
+	if (dstInfo == NULL || width < 0 || height < 0)
+		@throw [OFInvalidArgumentException exception];
+
+	stride = (size_t)width * bytesPerPixel(dstInfo);
+	pixels = g_malloc_n(MAX(height, 1), MAX(stride, 1));
+
+	@try {
+		[self convertPixels:source format:sourceFormat stride:sourceStride toPixels:pixels format:destinationFormat stride:stride width:width height:height];
+	} @catch (id e) {
+		g_free(pixels);
+		@throw e;
+	}
+
+	if (destinationStride != NULL)
+		*destinationStride = stride;
+
+	return g_bytes_new_take(pixels, stride * (size_t)height);
+}
+
++ (OGdkMemoryTexture*)memoryTextureWithPixels:(const void*)source format:(GdkMemoryFormat)sourceFormat stride:(size_t)sourceStride width:(int)width height:(int)height textureFormat:(GdkMemoryFormat)textureFormat
+{
+	size_t stride;
+	GBytes* bytes = [self bytesByConvertingPixels:source format:sourceFormat stride:sourceStride toFormat:textureFormat width:width height:height destinationStride:&stride];
+	OGdkMemoryTexture* texture;
+
+	@try {
+		texture = [OGdkMemoryTexture memoryTextureWithWidth:width height:height format:textureFormat bytes:bytes stride:stride];
+	} @finally {
+		g_bytes_unref(bytes);
+	}
+
+	return texture;
+}
+
++ (OGdkMemoryTexture*)memoryTextureWithPixbuf:(OGdkPixbuf*)pixbuf textureFormat:(GdkMemoryFormat)textureFormat
+{
+	GdkPixbuf* gPixbuf = [pixbuf castedGObject];
+	GdkMemoryFormat format;
+
+	if (gdk_pixbuf_get_bits_per_sample(gPixbuf) != 8 || gdk_pixbuf_get_colorspace(gPixbuf) != GDK_COLORSPACE_RGB)
+		@throw [OFInvalidArgumentException exception];
+
+	format = (gdk_pixbuf_get_has_alpha(gPixbuf) ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8);
+
+	return [self memoryTextureWithPixels:gdk_pixbuf_read_pixels(gPixbuf) format:format stride:(size_t)gdk_pixbuf_get_rowstride(gPixbuf) width:gdk_pixbuf_get_width(gPixbuf) height:gdk_pixbuf_get_height(gPixbuf) textureFormat:textureFormat];
+}
+
++ (OFString*)implementationName
+{
+	ensureKernels();
+
+	return [OFString stringWithUTF8String:kernels.name];
+}
+
+@end
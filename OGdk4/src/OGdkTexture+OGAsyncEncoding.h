@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkTexture.h"
+
+@class OGCancellable;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block which is called with the result of an asynchronous encoding.
+ *
+ * @param bytes the encoded image, or %NULL on error
+ * @param error the error that occurred, or %NULL; %G_IO_ERROR_CANCELLED if
+ *   the encoding was cancelled
+ */
+typedef void (^OGdkTextureEncodingHandler)(GBytes* bytes, const GError* error);
+
+/**
+ * A block which is called once an image file has been written.
+ *
+ * @param error the error that occurred, or %NULL; %G_IO_ERROR_CANCELLED if
+ *   the encoding was cancelled
+ */
+typedef void (^OGdkTextureSaveHandler)(const GError* error);
+#endif
+
+/**
+ * Asynchronous variants of the saving methods of `OGdkTexture`.
+ *
+ * The texture is downloaded once on the calling thread, which is necessary
+ * for textures living on the GPU, and encoded on a worker thread. PNG
+ * images are filtered and deflated in horizontal bands on a shared thread
+ * pool; the compressed bands are joined into a single zlib stream, so the
+ * result is a regular PNG file. Textures with more than 8 bits per channel
+ * are saved with 16 bits per channel, like -saveToPngBytes does.
+ *
+ * The handlers are called on the thread-default main context of the calling
+ * thread.
+ */
+@interface OGdkTexture (OGAsyncEncoding)
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Encodes the texture as PNG on worker threads.
+ *
+ * @param cancellable a cancellable to abort the encoding, or %nil
+ * @param handler the block to call with the PNG data
+ */
+- (void)saveToPngBytesAsyncWithCancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureEncodingHandler)handler;
+
+/**
+ * Encodes the texture as PNG on worker threads and writes it to a file.
+ *
+ * @param filename the path of the file to write
+ * @param cancellable a cancellable to abort the encoding, or %nil
+ * @param handler the block to call once the file was written
+ */
+- (void)saveToPngAsyncWithFilename:(OFString*)filename cancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureSaveHandler)handler;
+
+/**
+ * Encodes the texture as TIFF on a worker thread.
+ *
+ * @param cancellable a cancellable to abort the encoding, or %nil
+ * @param handler the block to call with the TIFF data
+ */
+- (void)saveToTiffBytesAsyncWithCancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureEncodingHandler)handler;
+#endif
+
+@end
@@ -0,0 +1,511 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zlib.h>
+
+#import "OGdkTexture+OGAsyncEncoding.h"
+
+#import <OGio/OGCancellable.h>
+
+#ifdef OF_HAVE_BLOCKS
+/* Rows handed to a worker at least, so that deflate has enough context. */
+#define OG_PNG_MIN_BAND_BYTES (256 * 1024)
+/* Bands per thread, so that uneven bands do not leave threads idle. */
+#define OG_PNG_BANDS_PER_THREAD 2
+/* The deflate window primed from the rows before a band. */
+#define OG_PNG_DICTIONARY_SIZE 32768
+
+typedef enum {
+	OGEncodingFormatPNG,
+	OGEncodingFormatTIFF
+} OGEncodingFormat;
+
+typedef struct {
+	OGEncodingFormat format;
+	GBytes* pixels;
+	GdkMemoryFormat memoryFormat;
+	int width;
+	int height;
+	size_t stride;
+	char* filename;
+} OGEncodingJob;
+
+typedef struct {
+	const guint8* pixels;
+	size_t stride;
+	int width;
+	int bytesPerPixel;
+	bool sixteenBit;
+	GCancellable* cancellable;
+	gint pendingBands;
+	GMutex mutex;
+	GCond cond;
+	bool done;
+} OGPNGJob;
+
+typedef struct {
+	OGPNGJob* job;
+	int firstRow;
+	int endRow;
+	bool last;
+	guint8* output;
+	size_t outputLength;
+	uLong adler;
+	size_t filteredLength;
+	bool failed;
+} OGPNGBand;
+
+static bool
+isDeepFormat(GdkMemoryFormat format)
+{
+	switch (format) {
+	case GDK_MEMORY_R16G16B16:
+	case GDK_MEMORY_R16G16B16A16_PREMULTIPLIED:
+	case GDK_MEMORY_R16G16B16A16:
+	case GDK_MEMORY_R16G16B16_FLOAT:
+	case GDK_MEMORY_R16G16B16A16_FLOAT_PREMULTIPLIED:
+	case GDK_MEMORY_R16G16B16A16_FLOAT:
+	case GDK_MEMORY_R32G32B32_FLOAT:
+	case GDK_MEMORY_R32G32B32A32_FLOAT_PREMULTIPLIED:
+	case GDK_MEMORY_R32G32B32A32_FLOAT:
+	case GDK_MEMORY_G16:
+	case GDK_MEMORY_G16A16:
+	case GDK_MEMORY_G16A16_PREMULTIPLIED:
+	case GDK_MEMORY_A16:
+	case GDK_MEMORY_A16_FLOAT:
+	case GDK_MEMORY_A32_FLOAT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void
+freeEncodingJob(gpointer data)
+{
+	OGEncodingJob* job = data;
+
+	g_bytes_unref(job->pixels);
+	g_free(job->filename);
+	g_free(job);
+}
+
+static inline guint8
+paeth(guint8 a, guint8 b, guint8 c)
+{
+	int p = (int)a + b - c;
+	int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+
+	if (pa <= pb && pa <= pc)
+		return a;
+
+	return (pb <= pc ? b : c);
+}
+
+/* Copies a row into PNG sample order, i.e. 16 bit samples big endian. */
+static void
+loadRow(const OGPNGJob* job, int row, guint8* destination)
+{
+	const guint8* source = job->pixels + (size_t)row * job->stride;
+	size_t length = (size_t)job->width * job->bytesPerPixel;
+
+	if (!job->sixteenBit) {
+		memcpy(destination, source, length);
+		return;
+	}
+
+	for (size_t i = 0; i < length; i += 2) {
+		guint16 sample;
+
+		memcpy(&sample, source + i, 2);
+		sample = GUINT16_TO_BE(sample);
+		memcpy(destination + i, &sample, 2);
+	}
+}
+
+/*
+ * Filters a row with the adaptive heuristic of libpng: the filter with the
+ * smallest sum of absolute differences wins.
+ */
+static void
+filterRow(const guint8* row, const guint8* previous, size_t length, int bpp, guint8* scratch, guint8* destination)
+{
+	guint8* candidates[4] = { scratch, scratch + length, scratch + 2 * length, scratch + 3 * length };
+	guint8 types[4] = { 0, 1, 2, 4 };
+	size_t bestSum = SIZE_MAX;
+	int best = 0;
+
+	for (size_t i = 0; i < length; i++) {
+		guint8 left = (i >= (size_t)bpp ? row[i - bpp] : 0);
+		guint8 up = (previous != NULL ? previous[i] : 0);
+		guint8 upLeft = (previous != NULL && i >= (size_t)bpp ? previous[i - bpp] : 0);
+
+		candidates[0][i] = row[i];
+		candidates[1][i] = row[i] - left;
+		candidates[2][i] = row[i] - up;
+		candidates[3][i] = row[i] - paeth(left, up, upLeft);
+	}
+
+	for (int f = 0; f < 4; f++) {
+		size_t sum = 0;
+
+		for (size_t i = 0; i < length; i++)
+			sum += (candidates[f][i] < 128 ? candidates[f][i] : 256 - candidates[f][i]);
+
+		if (sum < bestSum) {
+			bestSum = sum;
+			best = f;
+		}
+	}
+
+	destination[0] = types[best];
+	memcpy(destination + 1, candidates[best], length);
+}
+
+static void
+encodeBand(gpointer data, gpointer userData)
+{
+	OGPNGBand* band = data;
+	OGPNGJob* job = band->job;
+	size_t rowLength = (size_t)job->width * job->bytesPerPixel;
+	size_t filteredRowLength = rowLength + 1;
+	int dictionaryRows = (int)((OG_PNG_DICTIONARY_SIZE + filteredRowLength - 1) / filteredRowLength);
+	int startRow = MAX(band->firstRow - dictionaryRows, 0);
+	size_t dictionaryLength = (size_t)(band->firstRow - startRow) * filteredRowLength;
+	guint8* filtered = NULL;
+	guint8* rows = NULL;
+	guint8* scratch = NULL;
+	z_stream stream;
+	bool streamInitialized = false;
+
+	band->failed = true;
+
+	if (g_cancellable_is_cancelled(job->cancellable))
+		goto finish;
+
+	filtered = g_malloc((size_t)(band->endRow - startRow) * filteredRowLength);
+	rows = g_malloc(2 * rowLength);
+	scratch = g_malloc(4 * rowLength);
+
+	/* The rows before the band are filtered again to prime the window. */
+	for (int row = startRow; row < band->endRow; row++) {
+		guint8* current = rows + (size_t)(row & 1) * rowLength;
+		guint8* previous = rows + (size_t)((row + 1) & 1) * rowLength;
+
+		if (row == startRow && row > 0)
+			loadRow(job, row - 1, previous);
+
+		loadRow(job, row, current);
+		filterRow(current, (row > 0 ? previous : NULL), rowLength, job->bytesPerPixel, scratch, filtered + (size_t)(row - startRow) * filteredRowLength);
+	}
+
+	band->filteredLength = (size_t)(band->endRow - band->firstRow) * filteredRowLength;
+	band->adler = adler32(adler32(0, NULL, 0), filtered + dictionaryLength, (uInt)band->filteredLength);
+
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		goto finish;
+	streamInitialized = true;
+
+	if (dictionaryLength > 0) {
+		size_t length = MIN(dictionaryLength, OG_PNG_DICTIONARY_SIZE);
+
+		deflateSetDictionary(&stream, filtered + dictionaryLength - length, (uInt)length);
+	}
+
+	/* Room for the sync flush marker of bands that are not the last one. */
+	band->outputLength = deflateBound(&stream, band->filteredLength) + 16;
+	band->output = g_malloc(band->outputLength);
+
+	stream.next_in = filtered + dictionaryLength;
+	stream.avail_in = (uInt)band->filteredLength;
+	stream.next_out = band->output;
+	stream.avail_out = (uInt)band->outputLength;
+
+	/*
+	 * A sync flush ends the band on a byte boundary without a final
+	 * block, so that the bands can simply be concatenated.
+	 */
+	if (deflate(&stream, (band->last ? Z_FINISH : Z_SYNC_FLUSH)) != (band->last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0)
+		goto finish;
+
+	band->outputLength -= stream.avail_out;
+	band->failed = false;
+
+finish:
+	if (streamInitialized)
+		deflateEnd(&stream);
+
+	g_free(filtered);
+	g_free(rows);
+	g_free(scratch);
+
+	if (g_atomic_int_dec_and_test(&job->pendingBands)) {
+		g_mutex_lock(&job->mutex);
+		job->done = true;
+		g_cond_signal(&job->cond);
+		g_mutex_unlock(&job->mutex);
+	}
+}
+
+static GThreadPool*
+sharedPool(void)
+{
+	static GThreadPool* pool = NULL;
+
+	if (g_once_init_enter(&pool)) {
+		GThreadPool* newPool = g_thread_pool_new(encodeBand, NULL, (gint)g_get_num_processors(), FALSE, NULL);
+
+		g_once_init_leave(&pool, newPool);
+	}
+
+	return pool;
+}
+
+static void
+appendChunk(GByteArray* png, const char* type, const guint8* data, size_t length)
+{
+	guint32 value = GUINT32_TO_BE((guint32)length);
+	uLong crc = crc32(0, (const Bytef*)type, 4);
+
+	g_byte_array_append(png, (const guint8*)&value, 4);
+	g_byte_array_append(png, (const guint8*)type, 4);
+
+	if (length > 0) {
+		g_byte_array_append(png, data, (guint)length);
+		crc = crc32(crc, data, (uInt)length);
+	}
+
+	value = GUINT32_TO_BE((guint32)crc);
+	g_byte_array_append(png, (const guint8*)&value, 4);
+}
+
+static GBytes*
+encodePNG(const OGEncodingJob* encodingJob, GCancellable* cancellable, GError** error)
+{
+	static const guint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	static const guint8 zlibHeader[2] = { 0x78, 0x9C };
+	OGPNGJob job;
+	OGPNGBand* bands;
+	int bandCount, bandRows;
+	size_t rowLength;
+	guint8 header[13];
+	guint32 value;
+	uLong adler;
+	GByteArray* png;
+	bool failed = false;
+
+	job.pixels = g_bytes_get_data(encodingJob->pixels, NULL);
+	job.stride = encodingJob->stride;
+	job.width = encodingJob->width;
+	job.sixteenBit = isDeepFormat(encodingJob->memoryFormat);
+	job.bytesPerPixel = (job.sixteenBit ? 8 : 4);
+	job.cancellable = cancellable;
+	job.done = false;
+
+	rowLength = (size_t)job.width * job.bytesPerPixel + 1;
+	bandRows = (int)MAX(OG_PNG_MIN_BAND_BYTES / rowLength, 1);
+	bandCount = MIN((encodingJob->height + bandRows - 1) / bandRows, (int)g_get_num_processors() * OG_PNG_BANDS_PER_THREAD);
+	bandCount = MAX(bandCount, 1);
+	bandRows = (encodingJob->height + bandCount - 1) / bandCount;
+	bandCount = (encodingJob->height + bandRows - 1) / bandRows;
+
+	bands = g_new0(OGPNGBand, bandCount);
+	g_atomic_int_set(&job.pendingBands, bandCount);
+	g_mutex_init(&job.mutex);
+	g_cond_init(&job.cond);
+
+	for (int i = 0; i < bandCount; i++) {
+		bands[i].job = &job;
+		bands[i].firstRow = i * bandRows;
+		bands[i].endRow = MIN((i + 1) * bandRows, encodingJob->height);
+		bands[i].last = (i == bandCount - 1);
+
+		g_thread_pool_push(sharedPool(), &bands[i], NULL);
+	}
+
+	g_mutex_lock(&job.mutex);
+	while (!job.done)
+		g_cond_wait(&job.cond, &job.mutex);
+	g_mutex_unlock(&job.mutex);
+
+	g_cond_clear(&job.cond);
+	g_mutex_clear(&job.mutex);
+
+	for (int i = 0; i < bandCount; i++)
+		failed |= bands[i].failed;
+
+	if (failed) {
+		for (int i = 0; i < bandCount; i++)
+			g_free(bands[i].output);
+		g_free(bands);
+
+		if (!g_cancellable_set_error_if_cancelled(cancellable, error))
+			g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, "Compressing the image data failed");
+
+		return NULL;
+	}
+
+	png = g_byte_array_new();
+	g_byte_array_append(png, signature, sizeof(signature));
+
+	value = GUINT32_TO_BE((guint32)encodingJob->width);
+	memcpy(header, &value, 4);
+	value = GUINT32_TO_BE((guint32)encodingJob->height);
+	memcpy(header + 4, &value, 4);
+	header[8] = (job.sixteenBit ? 16 : 8);
+	/* RGBA, deflate, adaptive filtering, no interlacing */
+	header[9] = 6;
+	header[10] = 0;
+	header[11] = 0;
+	header[12] = 0;
+	appendChunk(png, "IHDR", header, sizeof(header));
+
+	/* One IDAT chunk per band, together they form one zlib stream. */
+	adler = adler32(0, NULL, 0);
+	for (int i = 0; i < bandCount; i++) {
+		GByteArray* data = g_byte_array_sized_new((guint)bands[i].outputLength + 6);
+
+		if (i == 0)
+			g_byte_array_append(data, zlibHeader, sizeof(zlibHeader));
+
+		g_byte_array_append(data, bands[i].output, (guint)bands[i].outputLength);
+		adler = adler32_combine(adler, bands[i].adler, (z_off_t)bands[i].filteredLength);
+
+		if (bands[i].last) {
+			value = GUINT32_TO_BE((guint32)adler);
+			g_byte_array_append(data, (const guint8*)&value, 4);
+		}
+
+		appendChunk(png, "IDAT", data->data, data->len);
+
+		g_byte_array_unref(data);
+		g_free(bands[i].output);
+	}
+
+	g_free(bands);
+
+	appendChunk(png, "IEND", NULL, 0);
+
+	return g_byte_array_free_to_bytes(png);
+}
+
+static void
+encodeInThread(GTask* task, gpointer sourceObject, gpointer taskData, GCancellable* cancellable)
+{
+	OGEncodingJob* job = taskData;
+	GError* error = NULL;
+	GBytes* bytes;
+
+	if (job->format == OGEncodingFormatPNG)
+		bytes = encodePNG(job, cancellable, &error);
+	else {
+		GdkTexture* texture = gdk_memory_texture_new(job->width, job->height, job->memoryFormat, job->pixels, job->stride);
+
+		/* Memory textures can be encoded on any thread. */
+		bytes = gdk_texture_save_to_tiff_bytes(texture);
+		g_object_unref(texture);
+	}
+
+	if (bytes != NULL && job->filename != NULL) {
+		gsize length;
+		const char* data = g_bytes_get_data(bytes, &length);
+
+		if (!g_file_set_contents(job->filename, data, (gssize)length, &error)) {
+			g_bytes_unref(bytes);
+			bytes = NULL;
+		}
+	}
+
+	if (bytes != NULL)
+		g_task_return_pointer(task, bytes, (GDestroyNotify)g_bytes_unref);
+	else
+		g_task_return_error(task, error);
+}
+
+static void
+encodingFinished(GObject* sourceObject, GAsyncResult* result, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+	OGdkTextureEncodingHandler handler = userData;
+	GError* error = NULL;
+	GBytes* bytes = g_task_propagate_pointer(G_TASK(result), &error);
+
+	@try {
+		handler(bytes, error);
+	} @finally {
+		[handler release];
+
+		if (bytes != NULL)
+			g_bytes_unref(bytes);
+		if (error != NULL)
+			g_error_free(error);
+	}
+
+	objc_autoreleasePoolPop(pool);
+}
+#endif
+
+@implementation OGdkTexture (OGAsyncEncoding)
+
+#ifdef OF_HAVE_BLOCKS
+- (void)og_encodeAsyncWithFormat:(OGEncodingFormat)format filename:(OFString*)filename cancellable:(OGCancellable*)cancellable handler:(OGdkTextureEncodingHandler)handler
+{
+	GdkTexture* texture = [self castedGObject];
+	GdkTextureDownloader* downloader;
+	OGEncodingJob* job;
+	GTask* task;
+
+	if (handler == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	job = g_new0(OGEncodingJob, 1);
+	job->format = format;
+	job->width = gdk_texture_get_width(texture);
+	job->height = gdk_texture_get_height(texture);
+	job->filename = (filename != nil ? g_strdup([filename UTF8String]) : NULL);
+
+	if (format == OGEncodingFormatPNG)
+		job->memoryFormat = (isDeepFormat(gdk_texture_get_format(texture)) ? GDK_MEMORY_R16G16B16A16 : GDK_MEMORY_R8G8B8A8);
+	else
+		job->memoryFormat = gdk_texture_get_format(texture);
+
+	/* The only step that needs the texture, GL textures must be downloaded here. */
+	downloader = gdk_texture_downloader_new(texture);
+	gdk_texture_downloader_set_format(downloader, job->memoryFormat);
+	job->pixels = gdk_texture_downloader_download_bytes(downloader, &job->stride);
+	gdk_texture_downloader_free(downloader);
+
+	task = g_task_new(NULL, [cancellable castedGObject], encodingFinished, [handler copy]);
+	g_task_set_task_data(task, job, freeEncodingJob);
+	g_task_run_in_thread(task, encodeInThread);
+	g_object_unref(task);
+}
+
+- (void)saveToPngBytesAsyncWithCancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureEncodingHandler)handler
+{
+	[self og_encodeAsyncWithFormat:OGEncodingFormatPNG filename:nil cancellable:cancellable handler:handler];
+}
+
+- (void)saveToPngAsyncWithFilename:(OFString*)filename cancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureSaveHandler)handler
+{
+	if (filename == nil || handler == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	[self og_encodeAsyncWithFormat:OGEncodingFormatPNG filename:filename cancellable:cancellable handler:^(GBytes* bytes, const GError* error) {
+		handler(error);
+	}];
+}
+
+- (void)saveToTiffBytesAsyncWithCancellable:(OGCancellable*)cancellable completionHandler:(OGdkTextureEncodingHandler)handler
+{
+	[self og_encodeAsyncWithFormat:OGEncodingFormatTIFF filename:nil cancellable:cancellable handler:handler];
+}
+#endif
+
+@end
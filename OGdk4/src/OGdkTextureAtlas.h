@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkPixbuf;
+@class OGdkTexture;
+@class OGdkTextureAtlas;
+@class OGdkTextureAtlasPage;
+
+/**
+ * An image packed into an `OGdkTextureAtlas`.
+ *
+ * An entry becomes invalid when it is removed from the atlas, when its page
+ * is evicted to make room for new images and when the atlas is deallocated.
+ */
+@interface OGdkTextureAtlasEntry : OFObject
+{
+	OGdkTextureAtlas* _atlas;
+	OGdkTextureAtlasPage* _page;
+	id _key;
+	int _x;
+	int _y;
+	int _width;
+	int _height;
+}
+
+/**
+ * Methods
+ */
+
+/**
+ * Whether the entry is still part of its atlas.
+ *
+ * @return whether the entry is valid
+ */
+- (bool)isValid;
+
+/**
+ * The key the entry was added with.
+ *
+ * @return the key of the entry
+ */
+- (id)key;
+
+/**
+ * The width of the image in pixels.
+ *
+ * @return the width of the image
+ */
+- (int)width;
+
+/**
+ * The height of the image in pixels.
+ *
+ * @return the height of the image
+ */
+- (int)height;
+
+/**
+ * The area of the image on its page texture, in pixels.
+ *
+ * @return the area of the image on its page
+ */
+- (graphene_rect_t)rect;
+
+/**
+ * The texture of the page holding the image.
+ *
+ * Adding images to a page replaces its texture, so the texture should be
+ * queried again for every frame. Images added in one go share one upload.
+ *
+ * @return the page texture, or %nil if the entry is not valid
+ */
+- (OGdkTexture*)pageTexture;
+
+@end
+
+/**
+ * An `OGdkTextureAtlas` packs many small images into a few large memory
+ * textures, the pages.
+ *
+ * Drawing thousands of small icons as separate textures means one upload
+ * and one texture per icon. Images added to an atlas are packed into pages
+ * with the skyline bottom-left heuristic and drawn as clipped parts of
+ * their page, see -[OGTKSnapshot appendAtlasEntry:bounds:], so all icons
+ * on a page share a single upload.
+ *
+ * Each image is surrounded by a one pixel border repeating its edge pixels,
+ * so scaled drawing does not blend in neighboring images. Images can be
+ * added and removed at any time. Space is reclaimed when all images of a
+ * page are removed; if all pages are full, the least recently used page is
+ * evicted as a whole.
+ *
+ * Memory textures are immutable, so adding an image to a page that was
+ * drawn since the last change copies the whole page into a new texture,
+ * pageSize² × 4 bytes, which the renderer uploads again. Adding images in
+ * batches between frames, rather than one per frame, keeps that to one
+ * copy per page and batch.
+ *
+ * Pages use the %GDK_MEMORY_B8G8R8A8_PREMULTIPLIED format. An atlas must
+ * only be used from one thread at a time.
+ */
+@interface OGdkTextureAtlas : OFObject
+{
+	int _pageSize;
+	unsigned int _maxPages;
+	OFMutableArray OF_GENERIC(OGdkTextureAtlasPage*)* _pages;
+	OFMutableDictionary* _entries;
+	unsigned long long _useCounter;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)atlasWithPageSize:(int)pageSize maxPages:(unsigned int)maxPages;
+
+/**
+ * Initializes a texture atlas.
+ *
+ * @param pageSize the width and height of the pages in pixels, or 0 for
+ *   1024
+ * @param maxPages the maximum number of pages, or 0 for no limit
+ * @return an initialized texture atlas
+ */
+- (instancetype)initWithPageSize:(int)pageSize maxPages:(unsigned int)maxPages;
+
+/**
+ * Methods
+ */
+
+/**
+ * Returns the entry for a key and marks its page as recently used.
+ *
+ * @param key the key of the entry
+ * @return the entry, or %nil if there is none
+ */
+- (OGdkTextureAtlasEntry*)entryForKey:(id)key;
+
+/**
+ * Packs a texture into the atlas, replacing an entry with the same key.
+ *
+ * @param texture the texture to pack; it must fit into a page with a one
+ *   pixel border on each side
+ * @param key the key to store the entry under
+ * @return the new entry
+ */
+- (OGdkTextureAtlasEntry*)addTexture:(OGdkTexture*)texture forKey:(id)key;
+
+/**
+ * Packs an 8 bit RGB or RGBA pixbuf into the atlas, replacing an entry with
+ * the same key.
+ *
+ * @param pixbuf the pixbuf to pack; it must fit into a page with a one pixel
+ *   border on each side
+ * @param key the key to store the entry under
+ * @return the new entry
+ */
+- (OGdkTextureAtlasEntry*)addPixbuf:(OGdkPixbuf*)pixbuf forKey:(id)key;
+
+/**
+ * Removes the entry for a key.
+ *
+ * @param key the key of the entry to remove
+ */
+- (void)removeEntryForKey:(id)key;
+
+/**
+ * Removes all entries and pages.
+ */
+- (void)removeAllEntries;
+
+/**
+ * The number of entries in the atlas.
+ *
+ * @return the number of entries
+ */
+- (size_t)count;
+
+/**
+ * The number of pages in the atlas.
+ *
+ * @return the number of pages
+ */
+- (size_t)pageCount;
+
+@end
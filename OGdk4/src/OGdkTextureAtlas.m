@@ -0,0 +1,540 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <string.h>
+
+#import "OGdkTextureAtlas.h"
+
+#import <OGdkPixbuf/OGdkPixbuf.h>
+
+#import "OGdkMemoryTexture.h"
+#import "OGdkPixelConverter.h"
+#import "OGdkTexture.h"
+
+#define OG_ATLAS_DEFAULT_PAGE_SIZE 1024
+#define OG_ATLAS_FORMAT GDK_MEMORY_B8G8R8A8_PREMULTIPLIED
+#define OG_ATLAS_BYTES_PER_PIXEL 4
+/* Border around every image, repeating its edge pixels. */
+#define OG_ATLAS_BORDER 1
+
+/* A horizontal segment of the skyline, everything below it is used. */
+typedef struct {
+	int x;
+	int y;
+	int width;
+} OGSkylineNode;
+
+@interface OGdkTextureAtlasPage : OFObject
+{
+	int _size;
+	guint8* _pixels;
+	GArray* _skyline;
+	OGdkMemoryTexture* _texture;
+	OFMutableSet OF_GENERIC(OGdkTextureAtlasEntry*)* _entries;
+	unsigned long long _lastUse;
+}
+
+- (instancetype)initWithSize:(int)size;
+- (bool)allocateWidth:(int)width height:(int)height x:(int*)x y:(int*)y;
+- (void)reset;
+- (guint8*)pixels;
+- (size_t)stride;
+- (void)invalidateTexture;
+- (OGdkTexture*)texture;
+- (OFMutableSet OF_GENERIC(OGdkTextureAtlasEntry*)*)entries;
+- (unsigned long long)lastUse;
+- (void)setLastUse:(unsigned long long)lastUse;
+@end
+
+@interface OGdkTextureAtlasEntry ()
+- (instancetype)og_initWithAtlas:(OGdkTextureAtlas*)atlas page:(OGdkTextureAtlasPage*)page key:(id)key x:(int)x y:(int)y width:(int)width height:(int)height;
+- (OGdkTextureAtlasPage*)og_page;
+- (void)og_invalidate;
+@end
+
+@interface OGdkTextureAtlas ()
+- (OGdkTextureAtlasEntry*)og_addEntryForKey:(id)key width:(int)width height:(int)height pixels:(guint8**)pixels stride:(size_t*)stride;
+- (void)og_extrudeEntry:(OGdkTextureAtlasEntry*)entry;
+- (void)og_removeEntry:(OGdkTextureAtlasEntry*)entry;
+- (void)og_evictPage:(OGdkTextureAtlasPage*)page;
+@end
+
+/*
+ * Returns the lowest y at which a rectangle fits with its left edge at the
+ * start of the node, or -1.
+ */
+static int
+skylineFit(GArray* skyline, guint index, int width, int height, int size)
+{
+	int x = g_array_index(skyline, OGSkylineNode, index).x;
+	int y = 0, remaining = width;
+
+	if (x + width > size)
+		return -1;
+
+	for (guint i = index; remaining > 0 && i < skyline->len; i++) {
+		const OGSkylineNode* node = &g_array_index(skyline, OGSkylineNode, i);
+
+		y = MAX(y, node->y);
+		if (y + height > size)
+			return -1;
+
+		remaining -= node->width;
+	}
+
+	return y;
+}
+
+@implementation OGdkTextureAtlasPage
+
+- (instancetype)initWithSize:(int)size
+{
+	self = [super init];
+
+	@try {
+		_size = size;
+		_pixels = g_malloc0((size_t)size * size * OG_ATLAS_BYTES_PER_PIXEL);
+		_skyline = g_array_new(FALSE, FALSE, sizeof(OGSkylineNode));
+		_entries = [[OFMutableSet alloc] init];
+
+		[self reset];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	g_free(_pixels);
+	if (_skyline != NULL)
+		g_array_unref(_skyline);
+	[_texture release];
+	[_entries release];
+
+	[super dealloc];
+}
+
+- (bool)allocateWidth:(int)width height:(int)height x:(int*)x y:(int*)y
+{
+	int bestY = G_MAXINT, bestWidth = G_MAXINT;
+	guint best = G_MAXUINT;
+	OGSkylineNode node;
+
+	/* Bottom-left: the lowest position, ties go to the narrowest node. */
+	for (guint i = 0; i < _skyline->len; i++) {
+		int fitY = skylineFit(_skyline, i, width, height, _size);
+		int nodeWidth = g_array_index(_skyline, OGSkylineNode, i).width;
+
+		if (fitY >= 0 && (fitY < bestY || (fitY == bestY && nodeWidth < bestWidth))) {
+			best = i;
+			bestY = fitY;
+			bestWidth = nodeWidth;
+		}
+	}
+
+	if (best == G_MAXUINT)
+		return false;
+
+	node.x = g_array_index(_skyline, OGSkylineNode, best).x;
+	node.y = bestY + height;
+	node.width = width;
+	g_array_insert_val(_skyline, best, node);
+
+	/* Cut the nodes now covered by the new one. */
+	for (guint i = best + 1; i < _skyline->len;) {
+		OGSkylineNode* previous = &g_array_index(_skyline, OGSkylineNode, i - 1);
+		OGSkylineNode* current = &g_array_index(_skyline, OGSkylineNode, i);
+		int overlap = previous->x + previous->width - current->x;
+
+		if (overlap <= 0)
+			break;
+
+		current->x += overlap;
+		current->width -= overlap;
+
+		if (current->width > 0)
+			break;
+
+		g_array_remove_index(_skyline, i);
+	}
+
+	for (guint i = 0; i + 1 < _skyline->len;) {
+		OGSkylineNode* current = &g_array_index(_skyline, OGSkylineNode, i);
+		OGSkylineNode* next = &g_array_index(_skyline, OGSkylineNode, i + 1);
+
+		if (current->y == next->y) {
+			current->width += next->width;
+			g_array_remove_index(_skyline, i + 1);
+		} else
+			i++;
+	}
+
+	*x = node.x;
+	*y = bestY;
+
+	return true;
+}
+
+- (void)reset
+{
+	OGSkylineNode node = { 0, 0, _size };
+
+	g_array_set_size(_skyline, 0);
+	g_array_append_val(_skyline, node);
+	[_entries removeAllObjects];
+}
+
+- (guint8*)pixels
+{
+	return _pixels;
+}
+
+- (size_t)stride
+{
+	return (size_t)_size * OG_ATLAS_BYTES_PER_PIXEL;
+}
+
+- (void)invalidateTexture
+{
+	[_texture release];
+	_texture = nil;
+}
+
+- (OGdkTexture*)texture
+{
+	if (_texture == nil) {
+		/* Textures are immutable, so the page is snapshotted. */
+		GBytes* bytes = g_bytes_new(_pixels, (size_t)_size * [self stride]);
+
+		@try {
+			_texture = [[OGdkMemoryTexture memoryTextureWithWidth:_size height:_size format:OG_ATLAS_FORMAT bytes:bytes stride:[self stride]] retain];
+		} @finally {
+			g_bytes_unref(bytes);
+		}
+	}
+
+	return _texture;
+}
+
+- (OFMutableSet OF_GENERIC(OGdkTextureAtlasEntry*)*)entries
+{
+	return _entries;
+}
+
+- (unsigned long long)lastUse
+{
+	return _lastUse;
+}
+
+- (void)setLastUse:(unsigned long long)lastUse
+{
+	_lastUse = lastUse;
+}
+
+@end
+
+@implementation OGdkTextureAtlasEntry
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)og_initWithAtlas:(OGdkTextureAtlas*)atlas page:(OGdkTextureAtlasPage*)page key:(id)key x:(int)x y:(int)y width:(int)width height:(int)height
+{
+	self = [super init];
+
+	@try {
+		_atlas = atlas;
+		_page = page;
+		_key = [key copy];
+		_x = x;
+		_y = y;
+		_width = width;
+		_height = height;
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_key release];
+
+	[super dealloc];
+}
+
+- (bool)isValid
+{
+	return (_page != nil);
+}
+
+- (id)key
+{
+	return _key;
+}
+
+- (int)width
+{
+	return _width;
+}
+
+- (int)height
+{
+	return _height;
+}
+
+- (graphene_rect_t)rect
+{
+	return GRAPHENE_RECT_INIT(_x, _y, _width, _height);
+}
+
+- (OGdkTexture*)pageTexture
+{
+	return [_page texture];
+}
+
+- (OGdkTextureAtlasPage*)og_page
+{
+	return _page;
+}
+
+- (void)og_invalidate
+{
+	_atlas = nil;
+	_page = nil;
+}
+
+@end
+
+@implementation OGdkTextureAtlas
+
++ (instancetype)atlasWithPageSize:(int)pageSize maxPages:(unsigned int)maxPages
+{
+	return [[[self alloc] initWithPageSize:pageSize maxPages:maxPages] autorelease];
+}
+
+- (instancetype)init
+{
+	return [self initWithPageSize:0 maxPages:0];
+}
+
+- (instancetype)initWithPageSize:(int)pageSize maxPages:(unsigned int)maxPages
+{
+	self = [super init];
+
+	@try {
+		if (pageSize == 0)
+			pageSize = OG_ATLAS_DEFAULT_PAGE_SIZE;
+
+		if (pageSize <= 2 * OG_ATLAS_BORDER || pageSize > 16384)
+			@throw [OFInvalidArgumentException exception];
+
+		_pageSize = pageSize;
+		_maxPages = maxPages;
+		_pages = [[OFMutableArray alloc] init];
+		_entries = [[OFMutableDictionary alloc] init];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	for (OGdkTextureAtlasEntry* entry in [_entries objectEnumerator])
+		[entry og_invalidate];
+
+	[_pages release];
+	[_entries release];
+
+	[super dealloc];
+}
+
+- (OGdkTextureAtlasEntry*)entryForKey:(id)key
+{
+	OGdkTextureAtlasEntry* entry = [_entries objectForKey:key];
+
+	if (entry != nil)
+		[[entry og_page] setLastUse:++_useCounter];
+
+	return entry;
+}
+
+- (OGdkTextureAtlasEntry*)addTexture:(OGdkTexture*)texture forKey:(id)key
+{
+	GdkTexture* gTexture = [texture castedGObject];
+	OGdkTextureAtlasEntry* entry;
+	GdkTextureDownloader* downloader;
+	guint8* pixels;
+	size_t stride;
+
+	entry = [self og_addEntryForKey:key width:gdk_texture_get_width(gTexture) height:gdk_texture_get_height(gTexture) pixels:&pixels stride:&stride];
+
+	downloader = gdk_texture_downloader_new(gTexture);
+	gdk_texture_downloader_set_format(downloader, OG_ATLAS_FORMAT);
+	gdk_texture_downloader_download_into(downloader, pixels, stride);
+	gdk_texture_downloader_free(downloader);
+
+	[self og_extrudeEntry:entry];
+
+	return entry;
+}
+
+- (OGdkTextureAtlasEntry*)addPixbuf:(OGdkPixbuf*)pixbuf forKey:(id)key
+{
+	GdkPixbuf* gPixbuf = [pixbuf castedGObject];
+	OGdkTextureAtlasEntry* entry;
+	guint8* pixels;
+	size_t stride;
+
+	if (gdk_pixbuf_get_bits_per_sample(gPixbuf) != 8 || gdk_pixbuf_get_colorspace(gPixbuf) != GDK_COLORSPACE_RGB)
+		@throw [OFInvalidArgumentException exception];
+
+	entry = [self og_addEntryForKey:key width:gdk_pixbuf_get_width(gPixbuf) height:gdk_pixbuf_get_height(gPixbuf) pixels:&pixels stride:&stride];
+
+	[OGdkPixelConverter convertPixels:gdk_pixbuf_read_pixels(gPixbuf) format:(gdk_pixbuf_get_has_alpha(gPixbuf) ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8) stride:(size_t)gdk_pixbuf_get_rowstride(gPixbuf) toPixels:pixels format:OG_ATLAS_FORMAT stride:stride width:[entry width] height:[entry height]];
+
+	[self og_extrudeEntry:entry];
+
+	return entry;
+}
+
+- (void)removeEntryForKey:(id)key
+{
+	OGdkTextureAtlasEntry* entry = [_entries objectForKey:key];
+
+	if (entry != nil)
+		[self og_removeEntry:entry];
+}
+
+- (void)removeAllEntries
+{
+	for (OGdkTextureAtlasEntry* entry in [_entries objectEnumerator])
+		[entry og_invalidate];
+
+	[_entries removeAllObjects];
+	[_pages removeAllObjects];
+}
+
+- (size_t)count
+{
+	return [_entries count];
+}
+
+- (size_t)pageCount
+{
+	return [_pages count];
+}
+
+- (OGdkTextureAtlasEntry*)og_addEntryForKey:(id)key width:(int)width height:(int)height pixels:(guint8**)pixels stride:(size_t*)stride
+{
+	int paddedWidth = width + 2 * OG_ATLAS_BORDER;
+	int paddedHeight = height + 2 * OG_ATLAS_BORDER;
+	OGdkTextureAtlasPage* page = nil;
+	OGdkTextureAtlasEntry* entry;
+	int x, y;
+
+	if (key == nil || width <= 0 || height <= 0 || paddedWidth > _pageSize || paddedHeight > _pageSize)
+		@throw [OFInvalidArgumentException exception];
+
+	[self removeEntryForKey:key];
+
+	for (OGdkTextureAtlasPage* candidate in _pages) {
+		if ([candidate allocateWidth:paddedWidth height:paddedHeight x:&x y:&y]) {
+			page = candidate;
+			break;
+		}
+	}
+
+	if (page == nil) {
+		if (_maxPages == 0 || [_pages count] < _maxPages) {
+			page = [[[OGdkTextureAtlasPage alloc] initWithSize:_pageSize] autorelease];
+			[_pages addObject:page];
+		} else {
+			OGdkTextureAtlasPage* leastRecentlyUsed = nil;
+
+			for (OGdkTextureAtlasPage* candidate in _pages)
+				if (leastRecentlyUsed == nil || [candidate lastUse] < [leastRecentlyUsed lastUse])
+					leastRecentlyUsed = candidate;
+
+			page = leastRecentlyUsed;
+			[self og_evictPage:page];
+		}
+
+		/* An empty page always fits an image that fits the page size. */
+		[page allocateWidth:paddedWidth height:paddedHeight x:&x y:&y];
+	}
+
+	entry = [[[OGdkTextureAtlasEntry alloc] og_initWithAtlas:self page:page key:key x:x + OG_ATLAS_BORDER y:y + OG_ATLAS_BORDER width:width height:height] autorelease];
+
+	[_entries setObject:entry forKey:key];
+	[[page entries] addObject:entry];
+	[page setLastUse:++_useCounter];
+	[page invalidateTexture];
+
+	*stride = [page stride];
+	*pixels = [page pixels] + (size_t)(y + OG_ATLAS_BORDER) * *stride + (size_t)(x + OG_ATLAS_BORDER) * OG_ATLAS_BYTES_PER_PIXEL;
+
+	return entry;
+}
+
+- (void)og_extrudeEntry:(OGdkTextureAtlasEntry*)entry
+{
+	OGdkTextureAtlasPage* page = [entry og_page];
+	graphene_rect_t rect = [entry rect];
+	size_t stride = [page stride];
+	int x = (int)rect.origin.x, y = (int)rect.origin.y;
+	int width = [entry width], height = [entry height];
+	guint8* first = [page pixels] + (size_t)y * stride + (size_t)x * OG_ATLAS_BYTES_PER_PIXEL;
+	size_t rowLength = (size_t)width * OG_ATLAS_BYTES_PER_PIXEL;
+
+	/* Top and bottom border rows, then the left and right columns. */
+	memcpy(first - stride, first, rowLength);
+	memcpy(first + (size_t)height * stride, first + (size_t)(height - 1) * stride, rowLength);
+
+	for (int row = -1; row <= height; row++) {
+		guint8* line = first + (ptrdiff_t)row * (ptrdiff_t)stride;
+
+		memcpy(line - OG_ATLAS_BYTES_PER_PIXEL, line, OG_ATLAS_BYTES_PER_PIXEL);
+		memcpy(line + rowLength, line + rowLength - OG_ATLAS_BYTES_PER_PIXEL, OG_ATLAS_BYTES_PER_PIXEL);
+	}
+}
+
+- (void)og_removeEntry:(OGdkTextureAtlasEntry*)entry
+{
+	OGdkTextureAtlasPage* page = [entry og_page];
+
+	[[entry retain] autorelease];
+
+	[[page entries] removeObject:entry];
+	[_entries removeObjectForKey:[entry key]];
+	[entry og_invalidate];
+
+	/* Skyline packing cannot reuse holes, only whole pages. */
+	if ([[page entries] count] == 0)
+		[page reset];
+}
+
+- (void)og_evictPage:(OGdkTextureAtlasPage*)page
+{
+	for (OGdkTextureAtlasEntry* entry in [page entries]) {
+		[_entries removeObjectForKey:[entry key]];
+		[entry og_invalidate];
+	}
+
+	[page reset];
+	[page invalidateTexture];
+}
+
+@end
@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkTexture;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block which is called on the main context once a thumbnail is available.
+ *
+ * @param texture the thumbnail, or %nil if the image could not be loaded
+ * @param error the error that occurred while loading the image, or %NULL
+ */
+typedef void (^OGdkThumbnailCacheCompletionHandler)(OGdkTexture* texture, const GError* error);
+#endif
+
+/**
+ * An `OGdkThumbnailCache` keeps thumbnails of image files in a single pack
+ * file, so they can be shown again without decoding the images.
+ *
+ * Thumbnails are keyed on the path, the modification time and the size of
+ * the image file and on the requested dimensions. They are stored as raw
+ * %GDK_MEMORY_R8G8B8A8_PREMULTIPLIED pixels in an append-only pack file that
+ * is memory-mapped for reading, so a cached thumbnail becomes a
+ * `GdkMemoryTexture` that directly references the mapping.
+ *
+ * Cache misses are decoded with gdk_pixbuf_new_from_file_at_scale() on a
+ * bounded pool of worker threads and appended to the pack file. Requests for
+ * a thumbnail that is already being decoded share the pending decode.
+ *
+ * Thumbnails of modified files are not removed from the pack file, use
+ * -removeAllThumbnails to reclaim their space. A record that was only
+ * partially written, e.g. because of a crash, is discarded when the pack
+ * file is opened.
+ *
+ * Apart from the worker threads, the cache must only be used from the thread
+ * that created it.
+ */
+@interface OGdkThumbnailCache : OFObject
+{
+	char* _packPath;
+	int _fd;
+	GMutex _mutex;
+	GHashTable* _index;
+	GMappedFile* _mapping;
+	guint64 _packSize;
+	GThreadPool* _pool;
+	GHashTable* _pending;
+	GMainContext* _mainContext;
+	size_t _hits;
+	size_t _misses;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)cacheWithPackPath:(OFString*)packPath workerCount:(unsigned int)workerCount;
+
+/**
+ * Initializes a thumbnail cache, opening or creating the pack file.
+ *
+ * @param packPath the path of the pack file
+ * @param workerCount the maximum number of images decoded in parallel, or 0
+ *   to use the number of processors
+ * @return an initialized thumbnail cache
+ */
+- (instancetype)initWithPackPath:(OFString*)packPath workerCount:(unsigned int)workerCount;
+
+/**
+ * Methods
+ */
+
+/**
+ * Returns the cached thumbnail for an image file without decoding anything.
+ *
+ * @param filename the path of the image file
+ * @param width the requested width of the thumbnail
+ * @param height the requested height of the thumbnail
+ * @return the cached thumbnail, or %nil if there is none
+ */
+- (OGdkTexture*)cachedTextureForFilename:(OFString*)filename width:(int)width height:(int)height;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Returns a thumbnail for an image file, decoding the image on a worker
+ * thread on a cache miss.
+ *
+ * The image is scaled to fit into the requested dimensions, preserving its
+ * aspect ratio. The handler is always called asynchronously on the main
+ * context of the thread that created the cache.
+ *
+ * @param filename the path of the image file
+ * @param width the requested width of the thumbnail
+ * @param height the requested height of the thumbnail
+ * @param handler the block to call with the thumbnail
+ */
+- (void)loadTextureForFilename:(OFString*)filename width:(int)width height:(int)height completionHandler:(OGdkThumbnailCacheCompletionHandler)handler;
+#endif
+
+/**
+ * Removes all thumbnails and truncates the pack file.
+ *
+ * Textures that were already handed out stay valid.
+ */
+- (void)removeAllThumbnails;
+
+/**
+ * The number of thumbnails in the pack file.
+ *
+ * @return the number of thumbnails
+ */
+- (size_t)count;
+
+/**
+ * The size of the pack file in bytes.
+ *
+ * @return the size of the pack file
+ */
+- (guint64)packSize;
+
+/**
+ * The number of lookups that were served from the pack file.
+ *
+ * @return the number of cache hits
+ */
+- (size_t)hits;
+
+/**
+ * The number of lookups that required decoding an image.
+ *
+ * @return the number of cache misses
+ */
+- (size_t)misses;
+
+@end
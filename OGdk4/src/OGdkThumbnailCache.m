@@ -0,0 +1,587 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib/gstdio.h>
+
+#import "OGdkThumbnailCache.h"
+
+#import "OGdkMemoryTexture.h"
+#import "OGdkPixelConverter.h"
+
+#define OG_THUMBNAIL_PACK_MAGIC "OGTHPK01"
+#define OG_THUMBNAIL_PACK_MAGIC_LENGTH 8
+#define OG_THUMBNAIL_RECORD_MAGIC 0x4F475452u
+#define OG_THUMBNAIL_FORMAT GDK_MEMORY_R8G8B8A8_PREMULTIPLIED
+
+/*
+ * Every record starts on a 16 byte boundary with this header, followed by
+ * the key and, again 16 byte aligned, the pixels. The pack file is only
+ * read by the machine that wrote it, so everything is in host byte order.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t keyLength;
+	uint32_t width;
+	uint32_t height;
+	uint32_t stride;
+	uint32_t format;
+	uint64_t pixelLength;
+} OGThumbnailRecordHeader;
+
+typedef struct {
+	OGdkThumbnailCache* cache;
+	char* filename;
+	char* key;
+	int width;
+	int height;
+	GBytes* pixels;
+	int pixelWidth;
+	int pixelHeight;
+	size_t stride;
+	GError* error;
+} OGThumbnailJob;
+
+#ifdef OF_HAVE_BLOCKS
+typedef struct {
+	OGdkTexture* texture;
+	OGdkThumbnailCacheCompletionHandler handler;
+} OGThumbnailHit;
+#endif
+
+@interface OGdkThumbnailCache ()
+- (void)decodeJob:(OGThumbnailJob*)job;
+- (void)deliverJob:(OGThumbnailJob*)job;
+@end
+
+static guint64
+alignRecord(guint64 offset)
+{
+	return (offset + 15) & ~(guint64)15;
+}
+
+static guint64
+pixelOffset(guint64 recordOffset, const OGThumbnailRecordHeader* header)
+{
+	return alignRecord(recordOffset + sizeof(*header) + header->keyLength);
+}
+
+static guint64
+recordEnd(guint64 recordOffset, const OGThumbnailRecordHeader* header)
+{
+	return alignRecord(pixelOffset(recordOffset, header) + header->pixelLength);
+}
+
+static bool
+writeAll(int fd, const void* buffer, size_t length, guint64 offset)
+{
+	const char* bytes = buffer;
+
+	while (length > 0) {
+		ssize_t written = pwrite(fd, bytes, length, (off_t)offset);
+
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+
+			return false;
+		}
+
+		bytes += written;
+		length -= (size_t)written;
+		offset += (guint64)written;
+	}
+
+	return true;
+}
+
+static void
+releaseObject(gpointer object)
+{
+	[(id)object release];
+}
+
+static void
+freeJob(OGThumbnailJob* job)
+{
+	g_free(job->filename);
+	g_free(job->key);
+	if (job->pixels != NULL)
+		g_bytes_unref(job->pixels);
+	g_clear_error(&job->error);
+	[job->cache release];
+	g_free(job);
+}
+
+static void
+decodeJob(gpointer data, gpointer userData)
+{
+	OGThumbnailJob* job = data;
+	void* pool = objc_autoreleasePoolPush();
+
+	[job->cache decodeJob:job];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static gboolean
+deliverJob(gpointer data)
+{
+	OGThumbnailJob* job = data;
+	void* pool = objc_autoreleasePoolPush();
+
+	@try {
+		[job->cache deliverJob:job];
+	} @finally {
+		freeJob(job);
+		objc_autoreleasePoolPop(pool);
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+#ifdef OF_HAVE_BLOCKS
+static gboolean
+deliverHit(gpointer data)
+{
+	OGThumbnailHit* hit = data;
+	void* pool = objc_autoreleasePoolPush();
+
+	@try {
+		hit->handler(hit->texture, NULL);
+	} @finally {
+		objc_autoreleasePoolPop(pool);
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+freeHit(gpointer data)
+{
+	OGThumbnailHit* hit = data;
+
+	[hit->texture release];
+	[hit->handler release];
+	g_free(hit);
+}
+#endif
+
+@implementation OGdkThumbnailCache
+
++ (instancetype)cacheWithPackPath:(OFString*)packPath workerCount:(unsigned int)workerCount
+{
+	return [[[self alloc] initWithPackPath:packPath workerCount:workerCount] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithPackPath:(OFString*)packPath workerCount:(unsigned int)workerCount
+{
+	self = [super init];
+
+	@try {
+		GError* err = NULL;
+
+		if (packPath == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		if (workerCount == 0)
+			workerCount = g_get_num_processors();
+
+		_fd = -1;
+		g_mutex_init(&_mutex);
+		_packPath = g_strdup([packPath UTF8String]);
+		_index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		_pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_ptr_array_unref);
+		_mainContext = g_main_context_ref_thread_default();
+
+		[self openPack];
+
+		_pool = g_thread_pool_new(decodeJob, NULL, (gint)workerCount, FALSE, &err);
+		[OGErrorException throwForError:err];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	/* Pending jobs retain the cache, so the pool is idle here. */
+	if (_pool != NULL)
+		g_thread_pool_free(_pool, FALSE, TRUE);
+
+	if (_mapping != NULL)
+		g_mapped_file_unref(_mapping);
+	if (_fd != -1)
+		close(_fd);
+	if (_index != NULL)
+		g_hash_table_unref(_index);
+	if (_pending != NULL)
+		g_hash_table_unref(_pending);
+	if (_mainContext != NULL)
+		g_main_context_unref(_mainContext);
+	g_free(_packPath);
+	g_mutex_clear(&_mutex);
+
+	[super dealloc];
+}
+
+/* Must be called with the mutex held or before any worker exists. */
+- (void)createPack
+{
+	if (_fd != -1)
+		close(_fd);
+	if (_mapping != NULL) {
+		g_mapped_file_unref(_mapping);
+		_mapping = NULL;
+	}
+
+	/*
+	 * Unlinking instead of truncating keeps the pages of textures that
+	 * still reference the old mapping valid.
+	 */
+	g_unlink(_packPath);
+
+	_fd = g_open(_packPath, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (_fd == -1)
+		@throw [OFOpenItemFailedException exceptionWithPath:[OFString stringWithUTF8String:_packPath] mode:@"w" errNo:errno];
+
+	if (!writeAll(_fd, OG_THUMBNAIL_PACK_MAGIC, OG_THUMBNAIL_PACK_MAGIC_LENGTH, 0))
+		@throw [OFWriteFailedException exceptionWithObject:self requestedLength:OG_THUMBNAIL_PACK_MAGIC_LENGTH bytesWritten:0 errNo:errno];
+
+	_packSize = OG_THUMBNAIL_PACK_MAGIC_LENGTH;
+	g_hash_table_remove_all(_index);
+}
+
+- (void)openPack
+{
+	char magic[OG_THUMBNAIL_PACK_MAGIC_LENGTH];
+	GStatBuf st;
+	guint64 offset = OG_THUMBNAIL_PACK_MAGIC_LENGTH;
+
+	_fd = g_open(_packPath, O_RDWR, 0);
+	if (_fd == -1 || fstat(_fd, &st) != 0 || st.st_size < OG_THUMBNAIL_PACK_MAGIC_LENGTH ||
+	    pread(_fd, magic, OG_THUMBNAIL_PACK_MAGIC_LENGTH, 0) != OG_THUMBNAIL_PACK_MAGIC_LENGTH ||
+	    memcmp(magic, OG_THUMBNAIL_PACK_MAGIC, OG_THUMBNAIL_PACK_MAGIC_LENGTH) != 0) {
+		[self createPack];
+		return;
+	}
+
+	while (offset + sizeof(OGThumbnailRecordHeader) <= (guint64)st.st_size) {
+		OGThumbnailRecordHeader header;
+		char* key;
+
+		if (pread(_fd, &header, sizeof(header), (off_t)offset) != sizeof(header) ||
+		    header.magic != OG_THUMBNAIL_RECORD_MAGIC ||
+		    (guint64)header.stride * header.height != header.pixelLength ||
+		    recordEnd(offset, &header) > (guint64)st.st_size)
+			break;
+
+		key = g_malloc(header.keyLength + 1);
+		if (pread(_fd, key, header.keyLength, (off_t)(offset + sizeof(header))) != (ssize_t)header.keyLength) {
+			g_free(key);
+			break;
+		}
+		key[header.keyLength] = '\0';
+
+		g_hash_table_replace(_index, key, g_memdup2(&offset, sizeof(offset)));
+		offset = recordEnd(offset, &header);
+	}
+
+	/* Drop a partially written record at the end. */
+	if (offset != (guint64)st.st_size && ftruncate(_fd, (off_t)offset) != 0) {
+		[self createPack];
+		return;
+	}
+
+	_packSize = offset;
+}
+
+- (char*)newKeyForFilename:(OFString*)filename width:(int)width height:(int)height
+{
+	GStatBuf st;
+
+	if (g_stat([filename UTF8String], &st) != 0)
+		return NULL;
+
+	return g_strdup_printf("%s\n%" G_GINT64_FORMAT "\n%" G_GINT64_FORMAT "\n%d\n%d", [filename UTF8String], (gint64)st.st_mtime, (gint64)st.st_size, width, height);
+}
+
+- (OGdkTexture*)textureForKey:(const char*)key
+{
+	const guint64* offsetPointer;
+	guint64 offset = 0;
+	GMappedFile* mapping = NULL;
+	OGThumbnailRecordHeader header;
+	const char* contents;
+	GBytes* bytes;
+	OGdkTexture* texture;
+
+	g_mutex_lock(&_mutex);
+
+	offsetPointer = g_hash_table_lookup(_index, key);
+	if (offsetPointer != NULL) {
+		offset = *offsetPointer;
+
+		if (_mapping == NULL || g_mapped_file_get_length(_mapping) < _packSize) {
+			if (_mapping != NULL)
+				g_mapped_file_unref(_mapping);
+			_mapping = g_mapped_file_new(_packPath, FALSE, NULL);
+		}
+
+		if (_mapping != NULL)
+			mapping = g_mapped_file_ref(_mapping);
+	}
+
+	g_mutex_unlock(&_mutex);
+
+	if (mapping == NULL)
+		return nil;
+
+	contents = g_mapped_file_get_contents(mapping);
+	memcpy(&header, contents + offset, sizeof(header));
+
+	bytes = g_bytes_new_with_free_func(contents + pixelOffset(offset, &header), (gsize)header.pixelLength, (GDestroyNotify)g_mapped_file_unref, mapping);
+
+	@try {
+		texture = [OGdkMemoryTexture memoryTextureWithWidth:(int)header.width height:(int)header.height format:(GdkMemoryFormat)header.format bytes:bytes stride:header.stride];
+	} @finally {
+		g_bytes_unref(bytes);
+	}
+
+	return texture;
+}
+
+- (OGdkTexture*)cachedTextureForFilename:(OFString*)filename width:(int)width height:(int)height
+{
+	char* key = [self newKeyForFilename:filename width:width height:height];
+	OGdkTexture* texture = nil;
+
+	if (key == NULL)
+		return nil;
+
+	@try {
+		texture = [self textureForKey:key];
+	} @finally {
+		g_free(key);
+	}
+
+	if (texture != nil)
+		_hits++;
+	else
+		_misses++;
+
+	return texture;
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (void)loadTextureForFilename:(OFString*)filename width:(int)width height:(int)height completionHandler:(OGdkThumbnailCacheCompletionHandler)handler
+{
+	char* key;
+	OGdkTexture* texture = nil;
+	GPtrArray* handlers;
+	OGThumbnailJob* job;
+
+	if (filename == nil || handler == nil || width <= 0 || height <= 0)
+		@throw [OFInvalidArgumentException exception];
+
+	/*
+	 * Files that cannot be stat'ed are still handed to a worker, so the
+	 * handler receives the error of the loader.
+	 */
+	key = [self newKeyForFilename:filename width:width height:height];
+	if (key != NULL)
+		texture = [self textureForKey:key];
+
+	if (texture != nil) {
+		OGThumbnailHit* hit = g_new(OGThumbnailHit, 1);
+		GSource* source = g_idle_source_new();
+
+		_hits++;
+		g_free(key);
+
+		hit->texture = [texture retain];
+		hit->handler = [handler copy];
+		g_source_set_callback(source, deliverHit, hit, freeHit);
+		g_source_attach(source, _mainContext);
+		g_source_unref(source);
+
+		return;
+	}
+
+	_misses++;
+
+	if (key == NULL)
+		key = g_strdup_printf("%s\n\n\n%d\n%d", [filename UTF8String], width, height);
+
+	handlers = g_hash_table_lookup(_pending, key);
+	if (handlers != NULL) {
+		g_ptr_array_add(handlers, [handler copy]);
+		g_free(key);
+		return;
+	}
+
+	handlers = g_ptr_array_new_with_free_func(releaseObject);
+	g_ptr_array_add(handlers, [handler copy]);
+	g_hash_table_insert(_pending, g_strdup(key), handlers);
+
+	job = g_new0(OGThumbnailJob, 1);
+	job->cache = [self retain];
+	job->filename = g_strdup([filename UTF8String]);
+	job->key = key;
+	job->width = width;
+	job->height = height;
+
+	g_thread_pool_push(_pool, job, NULL);
+}
+#endif
+
+- (void)appendJob:(OGThumbnailJob*)job
+{
+	OGThumbnailRecordHeader header;
+	static const char padding[16] = { 0 };
+	guint64 offset, pixelsAt, end;
+	size_t keyLength = strlen(job->key);
+	bool written;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = OG_THUMBNAIL_RECORD_MAGIC;
+	header.keyLength = (uint32_t)keyLength;
+	header.width = (uint32_t)job->pixelWidth;
+	header.height = (uint32_t)job->pixelHeight;
+	header.stride = (uint32_t)job->stride;
+	header.format = OG_THUMBNAIL_FORMAT;
+	header.pixelLength = g_bytes_get_size(job->pixels);
+
+	g_mutex_lock(&_mutex);
+
+	offset = _packSize;
+	pixelsAt = pixelOffset(offset, &header);
+	end = recordEnd(offset, &header);
+
+	written = (writeAll(_fd, &header, sizeof(header), offset) &&
+	    writeAll(_fd, job->key, keyLength, offset + sizeof(header)) &&
+	    writeAll(_fd, padding, (size_t)(pixelsAt - offset - sizeof(header) - keyLength), offset + sizeof(header) + keyLength) &&
+	    writeAll(_fd, g_bytes_get_data(job->pixels, NULL), (size_t)header.pixelLength, pixelsAt) &&
+	    writeAll(_fd, padding, (size_t)(end - pixelsAt - header.pixelLength), pixelsAt + header.pixelLength));
+
+	/*
+	 * A failed write leaves garbage after the last record, which is
+	 * overwritten by the next append and cut off on the next open.
+	 */
+	if (written) {
+		_packSize = end;
+		g_hash_table_replace(_index, g_strdup(job->key), g_memdup2(&offset, sizeof(offset)));
+	}
+
+	g_mutex_unlock(&_mutex);
+}
+
+- (void)decodeJob:(OGThumbnailJob*)job
+{
+	GdkPixbuf* pixbuf = gdk_pixbuf_new_from_file_at_scale(job->filename, job->width, job->height, TRUE, &job->error);
+
+	if (pixbuf != NULL) {
+		GdkMemoryFormat format = (gdk_pixbuf_get_has_alpha(pixbuf) ? GDK_MEMORY_R8G8B8A8 : GDK_MEMORY_R8G8B8);
+
+		job->pixelWidth = gdk_pixbuf_get_width(pixbuf);
+		job->pixelHeight = gdk_pixbuf_get_height(pixbuf);
+
+		@try {
+			job->pixels = [OGdkPixelConverter bytesByConvertingPixels:gdk_pixbuf_read_pixels(pixbuf) format:format stride:(size_t)gdk_pixbuf_get_rowstride(pixbuf) toFormat:OG_THUMBNAIL_FORMAT width:job->pixelWidth height:job->pixelHeight destinationStride:&job->stride];
+		} @catch (id e) {
+			g_set_error_literal(&job->error, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_UNKNOWN_TYPE, "Unsupported pixel format");
+		}
+
+		g_object_unref(pixbuf);
+	}
+
+	if (job->pixels != NULL)
+		[self appendJob:job];
+
+	g_main_context_invoke(_mainContext, deliverJob, job);
+}
+
+- (void)deliverJob:(OGThumbnailJob*)job
+{
+	OGdkTexture* texture = nil;
+	char* pendingKey = NULL;
+	GPtrArray* handlers = NULL;
+
+	if (job->pixels != NULL)
+		texture = [OGdkMemoryTexture memoryTextureWithWidth:job->pixelWidth height:job->pixelHeight format:OG_THUMBNAIL_FORMAT bytes:job->pixels stride:job->stride];
+
+	if (!g_hash_table_steal_extended(_pending, job->key, (gpointer*)&pendingKey, (gpointer*)&handlers))
+		return;
+	g_free(pendingKey);
+
+	@try {
+#ifdef OF_HAVE_BLOCKS
+		for (guint i = 0; i < handlers->len; i++) {
+			OGdkThumbnailCacheCompletionHandler handler = g_ptr_array_index(handlers, i);
+
+			handler(texture, job->error);
+		}
+#endif
+	} @finally {
+		g_ptr_array_unref(handlers);
+	}
+}
+
+- (void)removeAllThumbnails
+{
+	g_mutex_lock(&_mutex);
+	@try {
+		[self createPack];
+	} @finally {
+		g_mutex_unlock(&_mutex);
+	}
+}
+
+- (size_t)count
+{
+	size_t count;
+
+	g_mutex_lock(&_mutex);
+	count = g_hash_table_size(_index);
+	g_mutex_unlock(&_mutex);
+
+	return count;
+}
+
+- (guint64)packSize
+{
+	guint64 packSize;
+
+	g_mutex_lock(&_mutex);
+	packSize = _packSize;
+	g_mutex_unlock(&_mutex);
+
+	return packSize;
+}
+
+- (size_t)hits
+{
+	return _hits;
+}
+
+- (size_t)misses
+{
+	return _misses;
+}
+
+@end
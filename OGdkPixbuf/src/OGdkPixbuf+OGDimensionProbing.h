@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkPixbuf.h"
+
+/**
+ * Fast determination of image dimensions without the loader modules.
+ *
+ * The dimensions of PNG, JPEG, WebP and GIF files are read directly from
+ * their headers in a memory mapping of the file, so only the pages holding
+ * the headers are ever read. Batches are probed on the calling thread and
+ * on a shared thread pool.
+ * Files in other formats, or with headers that cannot be parsed, fall back
+ * to +fileInfoWithFilename:width:height: on the calling thread.
+ *
+ * Like +fileInfoWithFilename:width:height:, the dimensions are the stored
+ * ones, an EXIF orientation is not applied.
+ */
+@interface OGdkPixbuf (OGDimensionProbing)
+
+/**
+ * Determines the dimensions of an image file.
+ *
+ * @param filename the path of the image file
+ * @param width return location for the width of the image
+ * @param height return location for the height of the image
+ * @return whether the dimensions could be determined
+ */
++ (bool)probeDimensionsOfFilename:(OFString*)filename width:(int*)width height:(int*)height;
+
+/**
+ * Determines the dimensions of several image files in parallel.
+ *
+ * Files whose dimensions cannot be determined get a width and height of 0.
+ *
+ * @param filenames the paths of the image files
+ * @param widths an array with an element for each filename to store the
+ *   widths in
+ * @param heights an array with an element for each filename to store the
+ *   heights in
+ * @param threadCount the maximum number of threads to use, including the
+ *   calling thread, or 0 to use the number of processors
+ * @return the number of files whose dimensions could be determined
+ */
++ (size_t)probeDimensionsOfFilenames:(OFArray OF_GENERIC(OFString*)*)filenames widths:(int*)widths heights:(int*)heights threadCount:(unsigned int)threadCount;
+
+@end
@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkPixbuf+OGDimensionProbing.h"
+
+#include <string.h>
+
+/* Batches with fewer files are probed on the calling thread. */
+#define OG_PROBE_MIN_PARALLEL_FILES 64
+/* Smallest chunk of files handed to a worker. */
+#define OG_PROBE_MIN_CHUNK_FILES 32
+/* Chunks per thread, so that slow files do not leave threads idle. */
+#define OG_PROBE_CHUNKS_PER_THREAD 4
+
+typedef struct {
+	const char* const* paths;
+	int* widths;
+	int* heights;
+	size_t count;
+	size_t chunkSize;
+	gint chunkCount;
+	gint nextChunk;
+	gint pendingWorkers;
+	GMutex mutex;
+	GCond cond;
+	bool done;
+} OGProbeJob;
+
+static inline guint32
+readBE16(const guint8* p)
+{
+	return ((guint32)p[0] << 8) | p[1];
+}
+
+static inline guint32
+readBE32(const guint8* p)
+{
+	return ((guint32)p[0] << 24) | ((guint32)p[1] << 16) | ((guint32)p[2] << 8) | p[3];
+}
+
+static inline guint32
+readLE16(const guint8* p)
+{
+	return p[0] | ((guint32)p[1] << 8);
+}
+
+static inline guint32
+readLE24(const guint8* p)
+{
+	return p[0] | ((guint32)p[1] << 8) | ((guint32)p[2] << 16);
+}
+
+static bool
+probePNG(const guint8* data, size_t length, guint32* width, guint32* height)
+{
+	static const guint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	if (length < 24 || memcmp(data, signature, 8) != 0 || memcmp(data + 12, "IHDR", 4) != 0)
+		return false;
+
+	*width = readBE32(data + 16);
+	*height = readBE32(data + 20);
+
+	return true;
+}
+
+static bool
+probeGIF(const guint8* data, size_t length, guint32* width, guint32* height)
+{
+	if (length < 10 || (memcmp(data, "GIF87a", 6) != 0 && memcmp(data, "GIF89a", 6) != 0))
+		return false;
+
+	*width = readLE16(data + 6);
+	*height = readLE16(data + 8);
+
+	return true;
+}
+
+static bool
+probeWebP(const guint8* data, size_t length, guint32* width, guint32* height)
+{
+	if (length < 30 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WEBP", 4) != 0)
+		return false;
+
+	if (memcmp(data + 12, "VP8 ", 4) == 0) {
+		/* Lossy: a frame tag and the start code precede the size. */
+		if (data[23] != 0x9D || data[24] != 0x01 || data[25] != 0x2A)
+			return false;
+
+		*width = readLE16(data + 26) & 0x3FFF;
+		*height = readLE16(data + 28) & 0x3FFF;
+	} else if (memcmp(data + 12, "VP8L", 4) == 0) {
+		guint32 bits;
+
+		if (data[20] != 0x2F)
+			return false;
+
+		bits = readLE16(data + 21) | (readLE16(data + 23) << 16);
+		*width = (bits & 0x3FFF) + 1;
+		*height = ((bits >> 14) & 0x3FFF) + 1;
+	} else if (memcmp(data + 12, "VP8X", 4) == 0) {
+		*width = readLE24(data + 24) + 1;
+		*height = readLE24(data + 27) + 1;
+	} else
+		return false;
+
+	return true;
+}
+
+static bool
+probeJPEG(const guint8* data, size_t length, guint32* width, guint32* height)
+{
+	size_t i = 2;
+
+	if (length < 4 || data[0] != 0xFF || data[1] != 0xD8)
+		return false;
+
+	while (i + 1 < length) {
+		guint8 marker;
+		size_t segmentLength;
+
+		if (data[i] != 0xFF)
+			return false;
+
+		marker = data[i + 1];
+
+		/* Any number of fill bytes may precede a marker. */
+		if (marker == 0xFF) {
+			i++;
+			continue;
+		}
+
+		i += 2;
+
+		/* Markers without a segment. */
+		if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+			continue;
+
+		/* The image data starts before any frame header was seen. */
+		if (marker == 0xD9 || marker == 0xDA)
+			return false;
+
+		if (i + 2 > length)
+			return false;
+
+		segmentLength = readBE16(data + i);
+		if (segmentLength < 2)
+			return false;
+
+		/* SOF0 to SOF15, except DHT, JPG and DAC. */
+		if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+			if (i + 7 > length)
+				return false;
+
+			*height = readBE16(data + i + 3);
+			*width = readBE16(data + i + 5);
+
+			return true;
+		}
+
+		i += segmentLength;
+	}
+
+	return false;
+}
+
+static void
+probeFile(const char* path, int* width, int* height)
+{
+	GMappedFile* file = g_mapped_file_new(path, FALSE, NULL);
+	const guint8* data;
+	size_t length;
+	guint32 w = 0, h = 0;
+	bool found;
+
+	*width = 0;
+	*height = 0;
+
+	if (file == NULL)
+		return;
+
+	/* Only the pages that are touched by the parsers are read. */
+	data = (const guint8*)g_mapped_file_get_contents(file);
+	length = g_mapped_file_get_length(file);
+
+	if (length >= 2 && data[0] == 0xFF)
+		found = probeJPEG(data, length, &w, &h);
+	else if (length >= 1 && data[0] == 0x89)
+		found = probePNG(data, length, &w, &h);
+	else if (length >= 1 && data[0] == 'G')
+		found = probeGIF(data, length, &w, &h);
+	else if (length >= 1 && data[0] == 'R')
+		found = probeWebP(data, length, &w, &h);
+	else
+		found = false;
+
+	g_mapped_file_unref(file);
+
+	/* A JPEG with the height in a DNL segment has a height of 0. */
+	if (found && w > 0 && h > 0 && w <= G_MAXINT && h <= G_MAXINT) {
+		*width = (int)w;
+		*height = (int)h;
+	}
+}
+
+/* Probes chunks until none are left, on the pool and the calling thread. */
+static void
+probeChunks(OGProbeJob* job)
+{
+	gint chunk;
+
+	while ((chunk = g_atomic_int_add(&job->nextChunk, 1)) < job->chunkCount) {
+		size_t end = MIN(job->count, ((size_t)chunk + 1) * job->chunkSize);
+
+		for (size_t i = (size_t)chunk * job->chunkSize; i < end; i++)
+			probeFile(job->paths[i], &job->widths[i], &job->heights[i]);
+	}
+}
+
+static void
+probeWorker(gpointer data, gpointer userData)
+{
+	OGProbeJob* job = data;
+
+	probeChunks(job);
+
+	if (g_atomic_int_dec_and_test(&job->pendingWorkers)) {
+		g_mutex_lock(&job->mutex);
+		job->done = true;
+		g_cond_signal(&job->cond);
+		g_mutex_unlock(&job->mutex);
+	}
+}
+
+static GThreadPool*
+sharedPool(void)
+{
+	static GThreadPool* pool = NULL;
+
+	if (g_once_init_enter(&pool)) {
+		GThreadPool* newPool = g_thread_pool_new(probeWorker, NULL, (gint)g_get_num_processors(), FALSE, NULL);
+
+		g_once_init_leave(&pool, newPool);
+	}
+
+	return pool;
+}
+
+@implementation OGdkPixbuf (OGDimensionProbing)
+
++ (bool)probeDimensionsOfFilename:(OFString*)filename width:(int*)width height:(int*)height
+{
+	if (filename == nil || width == NULL || height == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	probeFile([filename UTF8String], width, height);
+
+	if (*width == 0 && [self fileInfoWithFilename:filename width:width height:height] == NULL) {
+		*width = 0;
+		*height = 0;
+	}
+
+	return (*width > 0);
+}
+
++ (size_t)probeDimensionsOfFilenames:(OFArray OF_GENERIC(OFString*)*)filenames widths:(int*)widths heights:(int*)heights threadCount:(unsigned int)threadCount
+{
+	size_t count = [filenames count], chunkCount, chunkSize, found = 0;
+	const char** paths;
+
+	if (count == 0)
+		return 0;
+
+	if (widths == NULL || heights == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	if (threadCount == 0)
+		threadCount = g_get_num_processors();
+
+	paths = g_new(const char*, count);
+
+	@try {
+		size_t i = 0;
+
+		for (OFString* filename in filenames)
+			paths[i++] = [filename UTF8String];
+
+		chunkCount = MIN(count / OG_PROBE_MIN_CHUNK_FILES, (size_t)threadCount * OG_PROBE_CHUNKS_PER_THREAD);
+
+		if (threadCount < 2 || count < OG_PROBE_MIN_PARALLEL_FILES || chunkCount < 2) {
+			for (i = 0; i < count; i++)
+				probeFile(paths[i], &widths[i], &heights[i]);
+		} else {
+			OGProbeJob job;
+			size_t workerCount;
+
+			chunkSize = (count + chunkCount - 1) / chunkCount;
+			chunkCount = (count + chunkSize - 1) / chunkSize;
+			/* The calling thread probes chunks as well. */
+			workerCount = MIN((size_t)threadCount, chunkCount) - 1;
+
+			job.paths = paths;
+			job.widths = widths;
+			job.heights = heights;
+			job.count = count;
+			job.chunkSize = chunkSize;
+			job.chunkCount = (gint)chunkCount;
+			job.done = false;
+			g_atomic_int_set(&job.nextChunk, 0);
+			g_atomic_int_set(&job.pendingWorkers, (gint)workerCount);
+			g_mutex_init(&job.mutex);
+			g_cond_init(&job.cond);
+
+			/* At most threadCount threads probe at once. */
+			for (i = 0; i < workerCount; i++)
+				g_thread_pool_push(sharedPool(), &job, NULL);
+
+			probeChunks(&job);
+
+			g_mutex_lock(&job.mutex);
+			while (!job.done)
+				g_cond_wait(&job.cond, &job.mutex);
+			g_mutex_unlock(&job.mutex);
+
+			g_cond_clear(&job.cond);
+			g_mutex_clear(&job.mutex);
+		}
+
+		/* The loader modules are only used for the files left over. */
+		i = 0;
+		for (OFString* filename in filenames) {
+			if (widths[i] == 0 && [self fileInfoWithFilename:filename width:&widths[i] height:&heights[i]] == NULL) {
+				widths[i] = 0;
+				heights[i] = 0;
+			}
+
+			if (widths[i] > 0)
+				found++;
+
+			i++;
+		}
+	} @finally {
+		g_free(paths);
+	}
+
+	return found;
+}
+
+@end
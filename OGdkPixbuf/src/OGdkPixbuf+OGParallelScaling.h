@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkPixbuf.h"
+
+/**
+ * Parallel variants of the scaling methods of `OGdkPixbuf`.
+ *
+ * The destination region is split into horizontal bands which are rendered
+ * by gdk_pixbuf_scale() on the calling thread and on a shared thread pool. Every destination pixel is
+ * computed from the same offset and scale as in the serial call, so the
+ * result is identical to the one of the corresponding serial method.
+ *
+ * Small regions are scaled on the calling thread.
+ */
+@interface OGdkPixbuf (OGParallelScaling)
+
+/**
+ * Like -scaleSimpleWithDestWidth:destHeight:interpType:, but renders the
+ * result on several threads.
+ *
+ * @param destWidth the width of destination image
+ * @param destHeight the height of destination image
+ * @param interpType the interpolation type for the transformation.
+ * @param threadCount the maximum number of threads to use, including the
+ *   calling thread, or 0 to use the number of processors
+ * @return the new pixbuf
+ */
+- (OGdkPixbuf*)scaleSimpleWithDestWidth:(int)destWidth destHeight:(int)destHeight interpType:(GdkInterpType)interpType threadCount:(unsigned int)threadCount;
+
+/**
+ * Like -scaleWithDest:destX:destY:destWidth:destHeight:offsetX:offsetY:scaleX:scaleY:interpType:,
+ * but renders the region on several threads.
+ *
+ * The source and destination must not be the same pixbuf.
+ *
+ * @param dest the #GdkPixbuf into which to render the results
+ * @param destX the left coordinate for region to render
+ * @param destY the top coordinate for region to render
+ * @param destWidth the width of the region to render
+ * @param destHeight the height of the region to render
+ * @param offsetX the offset in the X direction (currently rounded to an integer)
+ * @param offsetY the offset in the Y direction (currently rounded to an integer)
+ * @param scaleX the scale factor in the X direction
+ * @param scaleY the scale factor in the Y direction
+ * @param interpType the interpolation type for the transformation.
+ * @param threadCount the maximum number of threads to use, including the
+ *   calling thread, or 0 to use the number of processors
+ */
+- (void)scaleWithDest:(OGdkPixbuf*)dest destX:(int)destX destY:(int)destY destWidth:(int)destWidth destHeight:(int)destHeight offsetX:(double)offsetX offsetY:(double)offsetY scaleX:(double)scaleX scaleY:(double)scaleY interpType:(GdkInterpType)interpType threadCount:(unsigned int)threadCount;
+
+@end
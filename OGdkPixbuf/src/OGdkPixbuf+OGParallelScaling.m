@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGdkPixbuf+OGParallelScaling.h"
+
+/* Regions with fewer destination pixels are not worth the dispatch. */
+#define OG_PARALLEL_SCALE_MIN_PIXELS (256 * 256)
+/* Smallest band handed to a worker. */
+#define OG_PARALLEL_SCALE_MIN_ROWS 16
+/* Bands per thread, so that uneven bands do not leave threads idle. */
+#define OG_PARALLEL_SCALE_BANDS_PER_THREAD 2
+
+typedef struct {
+	const GdkPixbuf* src;
+	GdkPixbuf* dest;
+	int destX;
+	int destY;
+	int destWidth;
+	int destHeight;
+	double offsetX;
+	double offsetY;
+	double scaleX;
+	double scaleY;
+	GdkInterpType interpType;
+	int bandCount;
+	int bandHeight;
+	gint nextBand;
+	gint pendingWorkers;
+	GMutex mutex;
+	GCond cond;
+	bool done;
+} OGScaleJob;
+
+/* Renders bands until none are left, on the pool and the calling thread. */
+static void
+scaleBands(OGScaleJob* job)
+{
+	int i;
+
+	while ((i = g_atomic_int_add(&job->nextBand, 1)) < job->bandCount) {
+		int destY = job->destY + i * job->bandHeight;
+		int destHeight = MIN(job->bandHeight, job->destHeight - i * job->bandHeight);
+
+		/*
+		 * The offsets are relative to the destination origin, not to
+		 * the rendered region, so every band uses the offsets of the
+		 * whole job.
+		 */
+		gdk_pixbuf_scale(job->src, job->dest, job->destX, destY, job->destWidth, destHeight, job->offsetX, job->offsetY, job->scaleX, job->scaleY, job->interpType);
+	}
+}
+
+static void
+scaleWorker(gpointer data, gpointer userData)
+{
+	OGScaleJob* job = data;
+
+	scaleBands(job);
+
+	if (g_atomic_int_dec_and_test(&job->pendingWorkers)) {
+		g_mutex_lock(&job->mutex);
+		job->done = true;
+		g_cond_signal(&job->cond);
+		g_mutex_unlock(&job->mutex);
+	}
+}
+
+static GThreadPool*
+sharedPool(void)
+{
+	static GThreadPool* pool = NULL;
+
+	if (g_once_init_enter(&pool)) {
+		GThreadPool* newPool = g_thread_pool_new(scaleWorker, NULL, (gint)g_get_num_processors(), FALSE, NULL);
+
+		g_once_init_leave(&pool, newPool);
+	}
+
+	return pool;
+}
+
+@implementation OGdkPixbuf (OGParallelScaling)
+
+- (OGdkPixbuf*)scaleSimpleWithDestWidth:(int)destWidth destHeight:(int)destHeight interpType:(GdkInterpType)interpType threadCount:(unsigned int)threadCount
+{
+	OGdkPixbuf* dest;
+
+	if (destWidth <= 0 || destHeight <= 0)
+		@throw [OFInvalidArgumentException exception];
+
+	/* Same special cases as gdk_pixbuf_scale_simple(). */
+	if ((destWidth == [self width] && destHeight == [self height]) || (size_t)destWidth * (size_t)destHeight < OG_PARALLEL_SCALE_MIN_PIXELS)
+		return [self scaleSimpleWithDestWidth:destWidth destHeight:destHeight interpType:interpType];
+
+	dest = [OGdkPixbuf pixbufWithColorspace:GDK_COLORSPACE_RGB hasAlpha:[self hasAlpha] bitsPerSample:8 width:destWidth height:destHeight];
+
+	[self scaleWithDest:dest destX:0 destY:0 destWidth:destWidth destHeight:destHeight offsetX:0 offsetY:0 scaleX:(double)destWidth / [self width] scaleY:(double)destHeight / [self height] interpType:interpType threadCount:threadCount];
+
+	return dest;
+}
+
+- (void)scaleWithDest:(OGdkPixbuf*)dest destX:(int)destX destY:(int)destY destWidth:(int)destWidth destHeight:(int)destHeight offsetX:(double)offsetX offsetY:(double)offsetY scaleX:(double)scaleX scaleY:(double)scaleY interpType:(GdkInterpType)interpType threadCount:(unsigned int)threadCount
+{
+	OGScaleJob job;
+	int bandCount, bandHeight, workerCount;
+
+	if (dest == nil || dest == self)
+		@throw [OFInvalidArgumentException exception];
+
+	if (threadCount == 0)
+		threadCount = g_get_num_processors();
+
+	/* Invalid regions get the usual criticals from the serial call. */
+	if (destWidth <= 0 || destHeight <= 0) {
+		[self scaleWithDest:dest destX:destX destY:destY destWidth:destWidth destHeight:destHeight offsetX:offsetX offsetY:offsetY scaleX:scaleX scaleY:scaleY interpType:interpType];
+		return;
+	}
+
+	bandCount = (int)MIN((unsigned int)(destHeight / OG_PARALLEL_SCALE_MIN_ROWS), threadCount * OG_PARALLEL_SCALE_BANDS_PER_THREAD);
+
+	if (threadCount < 2 || bandCount < 2 || (size_t)destWidth * (size_t)destHeight < OG_PARALLEL_SCALE_MIN_PIXELS) {
+		[self scaleWithDest:dest destX:destX destY:destY destWidth:destWidth destHeight:destHeight offsetX:offsetX offsetY:offsetY scaleX:scaleX scaleY:scaleY interpType:interpType];
+		return;
+	}
+
+	bandHeight = (destHeight + bandCount - 1) / bandCount;
+	bandCount = (destHeight + bandHeight - 1) / bandHeight;
+	/* The calling thread renders bands as well. */
+	workerCount = (int)MIN(threadCount, (unsigned int)bandCount) - 1;
+
+	job.src = [self castedGObject];
+	job.dest = [dest castedGObject];
+	job.destX = destX;
+	job.destY = destY;
+	job.destWidth = destWidth;
+	job.destHeight = destHeight;
+	job.offsetX = offsetX;
+	job.offsetY = offsetY;
+	job.scaleX = scaleX;
+	job.scaleY = scaleY;
+	job.interpType = interpType;
+	job.bandCount = bandCount;
+	job.bandHeight = bandHeight;
+	job.done = false;
+	g_atomic_int_set(&job.nextBand, 0);
+	g_atomic_int_set(&job.pendingWorkers, workerCount);
+	g_mutex_init(&job.mutex);
+	g_cond_init(&job.cond);
+
+	/*
+	 * Both calls may convert the pixel storage of a pixbuf on first use,
+	 * which must not race between the workers.
+	 */
+	gdk_pixbuf_read_pixels(job.src);
+	gdk_pixbuf_get_pixels(job.dest);
+
+	/*
+	 * At most threadCount threads render at once, however large the pool
+	 * is. Workers that start after all bands are taken return at once.
+	 */
+	for (int i = 0; i < workerCount; i++)
+		g_thread_pool_push(sharedPool(), &job, NULL);
+
+	scaleBands(&job);
+
+	g_mutex_lock(&job.mutex);
+	while (!job.done)
+		g_cond_wait(&job.cond, &job.mutex);
+	g_mutex_unlock(&job.mutex);
+
+	g_cond_clear(&job.cond);
+	g_mutex_clear(&job.mutex);
+}
+
+@end
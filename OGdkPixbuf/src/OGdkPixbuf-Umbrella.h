@@ -13,3 +13,7 @@
 #import "OGdkPixbufAnimationIter.h"
 #import "OGdkPixbufLoader.h"
 #import "OGdkPixbufSimpleAnim.h"
+
+// Additional classes
+#import "OGdkPixbuf+OGDimensionProbing.h"
+#import "OGdkPixbuf+OGParallelScaling.h"
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gsk/gsk.h>
+
+#import <OGPango/OGPangoDisplayList.h>
+
+@interface OGPangoDisplayList (OGskRenderNode)
+
+/**
+ * Converts the recorded operations into a render node.
+ *
+ * The node can be cached and be appended with -[OGTKSnapshot appendNode:] as
+ * long as the recorded text does not change. Error underlines are drawn as
+ * plain rectangles.
+ *
+ * @param color the color to use for operations that were recorded without
+ *   a color
+ * @return a new render node, or %NULL if nothing visible was recorded
+ */
+- (GskRenderNode*)renderNodeWithDefaultColor:(const GdkRGBA*)color;
+
+@end
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGPangoDisplayList+OGskRenderNode.h"
+
+static void
+colorForOp(const OGPangoDisplayOp* op, const GdkRGBA* defaultColor, GdkRGBA* color)
+{
+	if (op->hasColor) {
+		color->red = op->color.red / 65535.f;
+		color->green = op->color.green / 65535.f;
+		color->blue = op->color.blue / 65535.f;
+		color->alpha = defaultColor->alpha;
+	} else
+		*color = *defaultColor;
+
+	if (op->alpha != 0)
+		color->alpha = op->alpha / 65535.f;
+}
+
+static GskRenderNode*
+trapezoidNode(const OGPangoDisplayOp* op, const GdkRGBA* color)
+{
+	GskPathBuilder* builder = gsk_path_builder_new();
+	GskPath* path;
+	GskRenderNode* fill;
+	GskRenderNode* node;
+	graphene_rect_t bounds;
+
+	gsk_path_builder_move_to(builder, op->x11, op->y1);
+	gsk_path_builder_line_to(builder, op->x21, op->y1);
+	gsk_path_builder_line_to(builder, op->x22, op->y2);
+	gsk_path_builder_line_to(builder, op->x12, op->y2);
+	gsk_path_builder_close(builder);
+	path = gsk_path_builder_free_to_path(builder);
+
+	if (!gsk_path_get_bounds(path, &bounds)) {
+		gsk_path_unref(path);
+		return NULL;
+	}
+
+	fill = gsk_color_node_new(color, &bounds);
+	node = gsk_fill_node_new(fill, path, GSK_FILL_RULE_WINDING);
+	gsk_render_node_unref(fill);
+	gsk_path_unref(path);
+
+	return node;
+}
+
+@implementation OGPangoDisplayList (OGskRenderNode)
+
+- (GskRenderNode*)renderNodeWithDefaultColor:(const GdkRGBA*)defaultColor
+{
+	const OGPangoDisplayOp* ops = [self ops];
+	size_t count = [self count];
+	GskRenderNode** children;
+	size_t childCount = 0;
+	GskRenderNode* node;
+
+	if (count == 0)
+		return NULL;
+
+	children = g_new(GskRenderNode*, count);
+
+	for (size_t i = 0; i < count; i++) {
+		const OGPangoDisplayOp* op = &ops[i];
+		GskRenderNode* child = NULL;
+		GdkRGBA color;
+
+		colorForOp(op, defaultColor, &color);
+
+		switch (op->kind) {
+		case OGPangoDisplayOpGlyphs:
+			child = gsk_text_node_new(op->font, op->glyphs, &color,
+			    &GRAPHENE_POINT_INIT((float)op->x / PANGO_SCALE, (float)op->y / PANGO_SCALE));
+			break;
+		case OGPangoDisplayOpRectangle:
+		case OGPangoDisplayOpErrorUnderline:
+			child = gsk_color_node_new(&color,
+			    &GRAPHENE_RECT_INIT((float)op->x / PANGO_SCALE, (float)op->y / PANGO_SCALE,
+			    (float)op->width / PANGO_SCALE, (float)op->height / PANGO_SCALE));
+			break;
+		case OGPangoDisplayOpTrapezoid:
+			child = trapezoidNode(op, &color);
+			break;
+		}
+
+		/* gsk_text_node_new() returns NULL for runs without visible glyphs. */
+		if (child != NULL)
+			children[childCount++] = child;
+	}
+
+	if (childCount == 0)
+		node = NULL;
+	else if (childCount == 1)
+		node = gsk_render_node_ref(children[0]);
+	else
+		node = gsk_container_node_new(children, (guint)childCount);
+
+	for (size_t i = 0; i < childCount; i++)
+		gsk_render_node_unref(children[i]);
+	g_free(children);
+
+	return node;
+}
+
+@end
@@ -12,3 +12,10 @@
 #import "OGskGLShader.h"
 #import "OGskRenderer.h"
 #import "OGskVulkanRenderer.h"
+
+// Additional classes
+#import "OGPangoDisplayList+OGskRenderNode.h"
+#import "OGskBatchRenderer.h"
+#import "OGskGLShaderArgs.h"
+#import "OGskPolylineBuilder.h"
+#import "OGskRenderNodeDiff.h"
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gsk/gsk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkDisplay;
+@class OGdkTexture;
+@class OGskCairoRenderer;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block which is called when a render node has been rendered.
+ *
+ * @param texture the rendered texture, or %nil if rendering failed
+ * @param pngBytes the texture encoded as PNG, or %NULL if no encoding was
+ *   requested or rendering failed
+ */
+typedef void (^OGskBatchRenderHandler)(OGdkTexture* texture, GBytes* pngBytes);
+#endif
+
+/**
+ * Throughput statistics of an `OGskBatchRenderer`. Times are in
+ * microseconds.
+ */
+typedef struct {
+	/** The number of nodes that were rendered */
+	guint64 renderedNodes;
+	/** The number of nodes that did not produce a texture */
+	guint64 failedNodes;
+	/** The number of pixels of all rendered textures */
+	guint64 renderedPixels;
+	/** The size of all PNG data produced */
+	guint64 encodedBytes;
+	/** The time spent rendering, summed up over all workers */
+	gint64 renderTime;
+	/** The time spent encoding, summed up over all workers */
+	gint64 encodeTime;
+	/** The time from the first submission to the last completed node */
+	gint64 elapsedTime;
+} OGskBatchRenderStatistics;
+
+/**
+ * A headless render service rendering many render node trees in parallel,
+ * e.g. chart or report previews on a server without display and GPU.
+ *
+ * The batch renderer owns a number of `OGskCairoRenderer`s, each realized
+ * through -[OGskRenderer realizeForDisplay:], and a worker thread per
+ * renderer. Submitted nodes, e.g. the result of -[OGTKSnapshot toNode], are
+ * rendered to textures by the next idle renderer and optionally encoded as
+ * PNG on the same worker, so the results can be streamed out as they
+ * complete. Only Cairo renderers are used, as they are the only renderers
+ * not bound to a GPU context and its thread.
+ *
+ * Completion handlers are called on the thread-default main context of the
+ * thread that submitted the node, in the order the nodes complete. A batch
+ * renderer must only be used from one thread.
+ */
+@interface OGskBatchRenderer : OFObject
+{
+	OFArray OF_GENERIC(OGskCairoRenderer*)* _renderers;
+	GAsyncQueue* _idleRenderers;
+	GThreadPool* _workers;
+	GMutex _statisticsMutex;
+	OGskBatchRenderStatistics _statistics;
+	gint64 _firstSubmissionTime;
+	size_t _pendingCount;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)batchRendererWithDisplay:(OGdkDisplay*)display rendererCount:(unsigned int)rendererCount;
+
+/**
+ * Initializes a batch renderer.
+ *
+ * @param display the display to realize the renderers for, or %nil to
+ *   realize them without display and surface
+ * @param rendererCount the number of renderers and worker threads, or 0
+ *   for one per processor
+ * @return an initialized batch renderer
+ */
+- (instancetype)initWithDisplay:(OGdkDisplay*)display rendererCount:(unsigned int)rendererCount;
+
+/**
+ * Methods
+ */
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Queues a render node tree for rendering.
+ *
+ * @param node the root of the tree; it is kept alive until it is rendered
+ * @param viewport the area to render, or %NULL for the bounds of the node
+ * @param encodeToPng whether to encode the texture with
+ *   -[OGdkTexture saveToPngBytes] on the worker
+ * @param handler the block to call with the result
+ */
+- (void)renderNode:(GskRenderNode*)node viewport:(const graphene_rect_t*)viewport encodeToPng:(bool)encodeToPng completionHandler:(OGskBatchRenderHandler)handler;
+#endif
+
+/**
+ * Runs the thread-default main context until all queued nodes have been
+ * rendered and their handlers have been called. Useful for command line
+ * tools that do not run a main loop.
+ */
+- (void)waitUntilAllRendered;
+
+/**
+ * The number of nodes that are queued or being rendered.
+ *
+ * @return the number of pending nodes
+ */
+- (size_t)pendingCount;
+
+/**
+ * The number of renderers and worker threads.
+ *
+ * @return the number of renderers
+ */
+- (unsigned int)rendererCount;
+
+/**
+ * The statistics since the batch renderer was created or the statistics
+ * were reset.
+ *
+ * @return the statistics
+ */
+- (OGskBatchRenderStatistics)statistics;
+
+/**
+ * The number of nodes rendered per second, based on the elapsed time of
+ * the statistics.
+ *
+ * @return the throughput in nodes per second
+ */
+- (double)throughput;
+
+/**
+ * Resets all statistics to zero.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <string.h>
+
+#import "OGskBatchRenderer.h"
+
+#import <OGdk4/OGdkDisplay.h>
+#import <OGdk4/OGdkTexture.h>
+
+#import "OGskCairoRenderer.h"
+
+typedef struct {
+	OGskBatchRenderer* batchRenderer;
+	GskRenderNode* node;
+	graphene_rect_t viewport;
+	bool hasViewport;
+	bool encodeToPng;
+	GMainContext* context;
+	id handler;
+	GdkTexture* texture;
+	GBytes* pngBytes;
+} OGBatchRenderJob;
+
+@interface OGskBatchRenderer ()
+- (void)og_renderJob:(OGBatchRenderJob*)job;
+- (void)og_finishJob:(OGBatchRenderJob*)job;
+@end
+
+static void
+freeJob(OGBatchRenderJob* job)
+{
+	gsk_render_node_unref(job->node);
+	g_main_context_unref(job->context);
+
+	if (job->texture != NULL)
+		g_object_unref(job->texture);
+	if (job->pngBytes != NULL)
+		g_bytes_unref(job->pngBytes);
+
+	g_free(job);
+}
+
+static void
+renderInWorker(gpointer data, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+	OGBatchRenderJob* job = data;
+
+	[job->batchRenderer og_renderJob:job];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static gboolean
+finishOnContext(gpointer data)
+{
+	void* pool = objc_autoreleasePoolPush();
+	OGBatchRenderJob* job = data;
+
+	[job->batchRenderer og_finishJob:job];
+
+	objc_autoreleasePoolPop(pool);
+
+	return G_SOURCE_REMOVE;
+}
+
+@implementation OGskBatchRenderer
+
++ (instancetype)batchRendererWithDisplay:(OGdkDisplay*)display rendererCount:(unsigned int)rendererCount
+{
+	return [[[self alloc] initWithDisplay:display rendererCount:rendererCount] autorelease];
+}
+
+- (instancetype)init
+{
+	return [self initWithDisplay:nil rendererCount:0];
+}
+
+- (instancetype)initWithDisplay:(OGdkDisplay*)display rendererCount:(unsigned int)rendererCount
+{
+	void* pool;
+
+	self = [super init];
+
+	g_mutex_init(&_statisticsMutex);
+
+	pool = objc_autoreleasePoolPush();
+
+	@try {
+		/*
+		 * Filled as renderers are realized, so -dealloc unrealizes
+		 * them if a later one fails.
+		 */
+		OFMutableArray* renderers = [[OFMutableArray alloc] init];
+		_renderers = renderers;
+
+		if (rendererCount == 0)
+			rendererCount = g_get_num_processors();
+
+		_idleRenderers = g_async_queue_new();
+
+		for (unsigned int i = 0; i < rendererCount; i++) {
+			OGskCairoRenderer* renderer = [OGskCairoRenderer cairoRenderer];
+			bool realized;
+
+			if (display != nil)
+				realized = [renderer realizeForDisplay:display];
+			else
+				realized = [renderer realizeWithSurface:nil];
+
+			if (!realized)
+				@throw [OFInitializationFailedException exceptionWithClass:[self class]];
+
+			[renderers addObject:renderer];
+			g_async_queue_push(_idleRenderers, [renderer castedGObject]);
+		}
+
+		[renderers makeImmutable];
+
+		/* Exclusive threads, one per renderer, so idle renderers are never waited for. */
+		_workers = g_thread_pool_new(renderInWorker, NULL, (gint)rendererCount, TRUE, NULL);
+		if (_workers == NULL)
+			@throw [OFInitializationFailedException exceptionWithClass:[self class]];
+	} @catch (id e) {
+		/* The exception may live in the pool. */
+		[e retain];
+		objc_autoreleasePoolPop(pool);
+		[e autorelease];
+
+		[self release];
+		@throw e;
+	}
+
+	objc_autoreleasePoolPop(pool);
+
+	return self;
+}
+
+- (void)dealloc
+{
+	/* Queued jobs retain the batch renderer, so the workers are idle here. */
+	if (_workers != NULL)
+		g_thread_pool_free(_workers, FALSE, TRUE);
+
+	for (OGskCairoRenderer* renderer in _renderers)
+		[renderer unrealize];
+
+	[_renderers release];
+
+	if (_idleRenderers != NULL)
+		g_async_queue_unref(_idleRenderers);
+
+	g_mutex_clear(&_statisticsMutex);
+
+	[super dealloc];
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (void)renderNode:(GskRenderNode*)node viewport:(const graphene_rect_t*)viewport encodeToPng:(bool)encodeToPng completionHandler:(OGskBatchRenderHandler)handler
+{
+	OGBatchRenderJob* job;
+
+	if (node == NULL || handler == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	job = g_new0(OGBatchRenderJob, 1);
+	job->batchRenderer = [self retain];
+	job->node = gsk_render_node_ref(node);
+	job->hasViewport = (viewport != NULL);
+	if (viewport != NULL)
+		job->viewport = *viewport;
+	job->encodeToPng = encodeToPng;
+	job->context = g_main_context_ref_thread_default();
+	job->handler = [handler copy];
+
+	g_mutex_lock(&_statisticsMutex);
+	if (_firstSubmissionTime == 0)
+		_firstSubmissionTime = g_get_monotonic_time();
+	g_mutex_unlock(&_statisticsMutex);
+
+	_pendingCount++;
+
+	g_thread_pool_push(_workers, job, NULL);
+}
+#endif
+
+- (void)og_renderJob:(OGBatchRenderJob*)job
+{
+	GskRenderer* renderer = g_async_queue_pop(_idleRenderers);
+	gint64 start, rendered, encoded;
+	guint64 pixels = 0;
+	GSource* source;
+
+	start = g_get_monotonic_time();
+	job->texture = gsk_renderer_render_texture(renderer, job->node, (job->hasViewport ? &job->viewport : NULL));
+	rendered = g_get_monotonic_time();
+
+	g_async_queue_push(_idleRenderers, renderer);
+
+	if (job->texture != NULL) {
+		pixels = (guint64)gdk_texture_get_width(job->texture) * (guint64)gdk_texture_get_height(job->texture);
+
+		/* Cairo renderers produce memory textures, which can be encoded on any thread. */
+		if (job->encodeToPng)
+			job->pngBytes = gdk_texture_save_to_png_bytes(job->texture);
+	}
+	encoded = g_get_monotonic_time();
+
+	g_mutex_lock(&_statisticsMutex);
+	if (job->texture != NULL) {
+		_statistics.renderedNodes++;
+		_statistics.renderedPixels += pixels;
+	} else
+		_statistics.failedNodes++;
+	if (job->pngBytes != NULL)
+		_statistics.encodedBytes += g_bytes_get_size(job->pngBytes);
+	_statistics.renderTime += rendered - start;
+	_statistics.encodeTime += encoded - rendered;
+	if (_firstSubmissionTime != 0)
+		_statistics.elapsedTime = encoded - _firstSubmissionTime;
+	g_mutex_unlock(&_statisticsMutex);
+
+	/*
+	 * Not g_main_context_invoke(), which would run the handler on this
+	 * thread if the context is not owned by the submitting thread.
+	 */
+	source = g_idle_source_new();
+	g_source_set_callback(source, finishOnContext, job, NULL);
+	g_source_attach(source, job->context);
+	g_source_unref(source);
+}
+
+- (void)og_finishJob:(OGBatchRenderJob*)job
+{
+#ifdef OF_HAVE_BLOCKS
+	OGskBatchRenderHandler handler = job->handler;
+#endif
+
+	_pendingCount--;
+
+	@try {
+#ifdef OF_HAVE_BLOCKS
+		OGdkTexture* texture = nil;
+
+		if (job->texture != NULL)
+			texture = OGWrapperClassAndObjectForGObject(job->texture);
+
+		handler(texture, job->pngBytes);
+#endif
+	} @finally {
+		[job->handler release];
+		[job->batchRenderer release];
+		freeJob(job);
+	}
+}
+
+- (void)waitUntilAllRendered
+{
+	GMainContext* context = g_main_context_ref_thread_default();
+
+	while (_pendingCount > 0)
+		g_main_context_iteration(context, TRUE);
+
+	g_main_context_unref(context);
+}
+
+- (size_t)pendingCount
+{
+	return _pendingCount;
+}
+
+- (unsigned int)rendererCount
+{
+	return (unsigned int)[_renderers count];
+}
+
+- (OGskBatchRenderStatistics)statistics
+{
+	OGskBatchRenderStatistics statistics;
+
+	g_mutex_lock(&_statisticsMutex);
+	statistics = _statistics;
+	g_mutex_unlock(&_statisticsMutex);
+
+	return statistics;
+}
+
+- (double)throughput
+{
+	OGskBatchRenderStatistics statistics = [self statistics];
+
+	if (statistics.elapsedTime <= 0)
+		return 0;
+
+	return (double)statistics.renderedNodes * G_USEC_PER_SEC / statistics.elapsedTime;
+}
+
+- (void)resetStatistics
+{
+	g_mutex_lock(&_statisticsMutex);
+	memset(&_statistics, 0, sizeof(_statistics));
+	_firstSubmissionTime = (_pendingCount > 0 ? g_get_monotonic_time() : 0);
+	g_mutex_unlock(&_statisticsMutex);
+}
+
+@end
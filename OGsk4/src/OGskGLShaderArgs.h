@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gsk/gsk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGskGLShader;
+
+/**
+ * Reusable, typed uniform arguments for an `OGskGLShader`.
+ *
+ * Animated shader effects need new arguments for every frame. Instead of
+ * formatting them from a va_list or packing them by hand, create one
+ * `OGskGLShaderArgs` per effect, set the changing uniforms by index and
+ * pass -bytes to -[OGTKSnapshot pushGlShader:bounds:takeArgs:].
+ *
+ * The offsets and types of the uniforms are looked up once when the object
+ * is created. Setters check the type of the uniform and write the value in
+ * place. -bytes copies the values into a buffer that returns to the object
+ * once the renderer has released it, so no memory is allocated in the
+ * steady state. If no uniform changed, the previous bytes are returned
+ * again without copying.
+ *
+ * Setters and -bytes must be called from one thread at a time. The
+ * returned bytes may be released on any thread.
+ */
+@interface OGskGLShaderArgs : OFObject
+{
+	OGskGLShader* _shader;
+	int _uniformCount;
+	int* _offsets;
+	GskGLUniformType* _types;
+	guchar* _values;
+	struct OGskGLShaderArgsBuffers* _buffers;
+	GBytes* _lastBytes;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)argsWithShader:(OGskGLShader*)shader;
+
+/**
+ * Initializes arguments for a shader with all uniforms set to zero.
+ *
+ * @param shader the shader the arguments are for
+ * @return initialized shader arguments
+ */
+- (instancetype)initWithShader:(OGskGLShader*)shader;
+
+/**
+ * Methods
+ */
+
+/**
+ * The shader the arguments are for.
+ *
+ * @return the shader
+ */
+- (OGskGLShader*)shader;
+
+/**
+ * Sets a uniform of type float.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setFloat:(float)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type int.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setInt:(gint32)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type uint.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setUint:(guint32)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type bool.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setBool:(bool)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type vec2.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setVec2:(const graphene_vec2_t*)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type vec3.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setVec3:(const graphene_vec3_t*)value atIndex:(int)idx;
+
+/**
+ * Sets a uniform of type vec4.
+ *
+ * @param value the value
+ * @param idx the index of the uniform
+ */
+- (void)setVec4:(const graphene_vec4_t*)value atIndex:(int)idx;
+
+/**
+ * Returns the current values in the format expected by the shader.
+ *
+ * @return a new reference to the arguments, suitable for `takeArgs:`
+ */
+- (GBytes*)bytes;
+
+@end
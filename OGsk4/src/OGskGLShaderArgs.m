@@ -0,0 +1,228 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <string.h>
+
+#import "OGskGLShaderArgs.h"
+
+#import "OGskGLShader.h"
+
+/* Buffers kept for reuse, enough for a few frames in flight. */
+#define OG_SHADER_ARGS_MAX_FREE_BUFFERS 4
+
+struct OGskGLShaderArgsBuffers {
+	GMutex mutex;
+	size_t size;
+	GSList* freeBuffers;
+	unsigned int freeCount;
+};
+
+typedef struct {
+	struct OGskGLShaderArgsBuffers* buffers;
+	guchar data[];
+} OGShaderArgsBuffer;
+
+static void
+clearBuffers(gpointer data)
+{
+	struct OGskGLShaderArgsBuffers* buffers = data;
+
+	g_slist_free_full(buffers->freeBuffers, g_free);
+	g_mutex_clear(&buffers->mutex);
+}
+
+/* Called when the renderer releases the bytes, possibly on another thread. */
+static void
+returnBuffer(gpointer data)
+{
+	OGShaderArgsBuffer* buffer = data;
+	struct OGskGLShaderArgsBuffers* buffers = buffer->buffers;
+
+	g_mutex_lock(&buffers->mutex);
+	if (buffers->freeCount < OG_SHADER_ARGS_MAX_FREE_BUFFERS) {
+		buffers->freeBuffers = g_slist_prepend(buffers->freeBuffers, buffer);
+		buffers->freeCount++;
+		buffer = NULL;
+	}
+	g_mutex_unlock(&buffers->mutex);
+
+	g_free(buffer);
+	g_atomic_rc_box_release_full(buffers, clearBuffers);
+}
+
+@implementation OGskGLShaderArgs
+
++ (instancetype)argsWithShader:(OGskGLShader*)shader
+{
+	return [[[self alloc] initWithShader:shader] autorelease];
+}
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+- (instancetype)initWithShader:(OGskGLShader*)shader
+{
+	self = [super init];
+
+	@try {
+		GskGLShader* glShader;
+		size_t size;
+
+		if (shader == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		_shader = [shader retain];
+		glShader = [shader castedGObject];
+
+		_uniformCount = gsk_gl_shader_get_n_uniforms(glShader);
+		_offsets = g_new(int, MAX(_uniformCount, 1));
+		_types = g_new(GskGLUniformType, MAX(_uniformCount, 1));
+
+		for (int i = 0; i < _uniformCount; i++) {
+			_offsets[i] = gsk_gl_shader_get_uniform_offset(glShader, i);
+			_types[i] = gsk_gl_shader_get_uniform_type(glShader, i);
+		}
+
+		size = gsk_gl_shader_get_args_size(glShader);
+		_values = g_malloc0(MAX(size, 1));
+
+		_buffers = g_atomic_rc_box_new0(struct OGskGLShaderArgsBuffers);
+		g_mutex_init(&_buffers->mutex);
+		_buffers->size = size;
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	if (_lastBytes != NULL)
+		g_bytes_unref(_lastBytes);
+
+	/* Bytes still held by renderers keep the buffers alive. */
+	if (_buffers != NULL)
+		g_atomic_rc_box_release_full(_buffers, clearBuffers);
+
+	g_free(_values);
+	g_free(_types);
+	g_free(_offsets);
+	[_shader release];
+
+	[super dealloc];
+}
+
+- (OGskGLShader*)shader
+{
+	return _shader;
+}
+
+- (void)og_setValue:(const void*)value size:(size_t)size type:(GskGLUniformType)type atIndex:(int)idx
+{
+	guchar* destination;
+
+	if (idx < 0 || idx >= _uniformCount || _types[idx] != type)
+		@throw [OFInvalidArgumentException exception];
+
+	destination = _values + _offsets[idx];
+
+	if (memcmp(destination, value, size) == 0)
+		return;
+
+	memcpy(destination, value, size);
+
+	if (_lastBytes != NULL) {
+		g_bytes_unref(_lastBytes);
+		_lastBytes = NULL;
+	}
+}
+
+- (void)setFloat:(float)value atIndex:(int)idx
+{
+	[self og_setValue:&value size:sizeof(value) type:GSK_GL_UNIFORM_TYPE_FLOAT atIndex:idx];
+}
+
+- (void)setInt:(gint32)value atIndex:(int)idx
+{
+	[self og_setValue:&value size:sizeof(value) type:GSK_GL_UNIFORM_TYPE_INT atIndex:idx];
+}
+
+- (void)setUint:(guint32)value atIndex:(int)idx
+{
+	[self og_setValue:&value size:sizeof(value) type:GSK_GL_UNIFORM_TYPE_UINT atIndex:idx];
+}
+
+- (void)setBool:(bool)value atIndex:(int)idx
+{
+	/* Stored as gboolean, like gsk_shader_args_builder_set_bool() does. */
+	gboolean boolValue = value;
+
+	[self og_setValue:&boolValue size:sizeof(boolValue) type:GSK_GL_UNIFORM_TYPE_BOOL atIndex:idx];
+}
+
+- (void)setVec2:(const graphene_vec2_t*)value atIndex:(int)idx
+{
+	float components[2];
+
+	if (value == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	graphene_vec2_to_float(value, components);
+	[self og_setValue:components size:sizeof(components) type:GSK_GL_UNIFORM_TYPE_VEC2 atIndex:idx];
+}
+
+- (void)setVec3:(const graphene_vec3_t*)value atIndex:(int)idx
+{
+	float components[3];
+
+	if (value == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	graphene_vec3_to_float(value, components);
+	[self og_setValue:components size:sizeof(components) type:GSK_GL_UNIFORM_TYPE_VEC3 atIndex:idx];
+}
+
+- (void)setVec4:(const graphene_vec4_t*)value atIndex:(int)idx
+{
+	float components[4];
+
+	if (value == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	graphene_vec4_to_float(value, components);
+	[self og_setValue:components size:sizeof(components) type:GSK_GL_UNIFORM_TYPE_VEC4 atIndex:idx];
+}
+
+- (GBytes*)bytes
+{
+	OGShaderArgsBuffer* buffer = NULL;
+
+	if (_lastBytes != NULL)
+		return g_bytes_ref(_lastBytes);
+
+	g_mutex_lock(&_buffers->mutex);
+	if (_buffers->freeBuffers != NULL) {
+		buffer = _buffers->freeBuffers->data;
+		_buffers->freeBuffers = g_slist_delete_link(_buffers->freeBuffers, _buffers->freeBuffers);
+		_buffers->freeCount--;
+	}
+	g_mutex_unlock(&_buffers->mutex);
+
+	if (buffer == NULL)
+		buffer = g_malloc(sizeof(OGShaderArgsBuffer) + MAX(_buffers->size, 1));
+
+	buffer->buffers = g_atomic_rc_box_acquire(_buffers);
+	memcpy(buffer->data, _values, _buffers->size);
+
+	_lastBytes = g_bytes_new_with_free_func(buffer->data, _buffers->size, returnBuffer, buffer);
+
+	return g_bytes_ref(_lastBytes);
+}
+
+@end
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gsk/gsk.h>
+
+#import <ObjFW/ObjFW.h>
+
+/**
+ * Builds `GskPath`s for polylines from point arrays in one call, e.g. for
+ * plots and waveforms passed to -[OGTKSnapshot appendStrokeWithPath:stroke:color:].
+ *
+ * The decimating variants reduce series with far more points than pixels
+ * to what can actually be seen: points are grouped into columns of the
+ * given width along the x axis, and of each column only the first, the
+ * lowest, the highest and the last point are kept, in their original
+ * order. The result is drawn exactly like the full series at that
+ * resolution, so a waveform with ten million samples becomes a path with a
+ * few thousand points.
+ *
+ * Points with a NaN coordinate interrupt the line; the next valid point
+ * starts a new contour.
+ *
+ * The returned paths are new references which must be released with
+ * gsk_path_unref(). All methods are thread-safe.
+ */
+@interface OGskPolylineBuilder : OFObject
+
+/**
+ * Builds a path through points.
+ *
+ * @param points the points
+ * @param count the number of points
+ * @param closed whether to close the contour back to the first point
+ * @return a new path, empty if there are fewer than two points
+ */
++ (GskPath*)pathWithPoints:(const graphene_point_t*)points count:(size_t)count closed:(bool)closed;
+
+/**
+ * Builds a path through points given as separate coordinate arrays.
+ *
+ * @param xValues the x coordinates
+ * @param yValues the y coordinates
+ * @param count the number of points
+ * @return a new path
+ */
++ (GskPath*)pathWithXValues:(const float*)xValues yValues:(const float*)yValues count:(size_t)count;
+
+/**
+ * Builds a path through points given as separate coordinate arrays,
+ * decimated to columns of the given width.
+ *
+ * @param xValues the x coordinates, which must not decrease
+ * @param yValues the y coordinates
+ * @param count the number of points
+ * @param columnWidth the width of a column, usually the width of a device
+ *   pixel in path coordinates; 0 disables the decimation
+ * @return a new path
+ */
++ (GskPath*)decimatedPathWithXValues:(const float*)xValues yValues:(const float*)yValues count:(size_t)count columnWidth:(float)columnWidth;
+
+/**
+ * Builds a path for evenly spaced samples spread over a rectangle,
+ * decimated to columns of the given width.
+ *
+ * The first sample is placed on the left and the last on the right edge of
+ * @bounds. @minimumValue is mapped to the bottom and @maximumValue to the
+ * top edge.
+ *
+ * @param samples the samples
+ * @param count the number of samples
+ * @param bounds the rectangle to spread the samples over
+ * @param minimumValue the value mapped to the bottom edge
+ * @param maximumValue the value mapped to the top edge
+ * @param columnWidth the width of a column, usually the width of a device
+ *   pixel; 0 disables the decimation
+ * @return a new path
+ */
++ (GskPath*)decimatedPathWithSamples:(const float*)samples count:(size_t)count bounds:(const graphene_rect_t*)bounds minimumValue:(float)minimumValue maximumValue:(float)maximumValue columnWidth:(float)columnWidth;
+
+@end
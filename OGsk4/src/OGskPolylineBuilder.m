@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <math.h>
+
+#import "OGskPolylineBuilder.h"
+
+/*
+ * A series of points, either with explicit x values or evenly spaced. The
+ * y values are mapped with yOffset + y * yScale.
+ */
+typedef struct {
+	const float* xValues;
+	const float* yValues;
+	float xStart;
+	float xStep;
+	float yOffset;
+	float yScale;
+} OGSeries;
+
+typedef struct {
+	GskPathBuilder* builder;
+	bool contourOpen;
+	/* The last index emitted, to avoid emitting a point twice. */
+	size_t lastEmitted;
+	bool emittedAny;
+} OGPolylineState;
+
+static inline float
+seriesX(const OGSeries* series, size_t i)
+{
+	return (series->xValues != NULL ? series->xValues[i] : series->xStart + (float)i * series->xStep);
+}
+
+static inline float
+seriesY(const OGSeries* series, size_t i)
+{
+	return series->yOffset + series->yValues[i] * series->yScale;
+}
+
+static void
+emitPoint(OGPolylineState* state, const OGSeries* series, size_t i)
+{
+	if (state->emittedAny && state->lastEmitted == i)
+		return;
+
+	if (state->contourOpen)
+		gsk_path_builder_line_to(state->builder, seriesX(series, i), seriesY(series, i));
+	else {
+		gsk_path_builder_move_to(state->builder, seriesX(series, i), seriesY(series, i));
+		state->contourOpen = true;
+	}
+
+	state->lastEmitted = i;
+	state->emittedAny = true;
+}
+
+/* Emits the kept points of a column in their original order. */
+static void
+emitColumn(OGPolylineState* state, const OGSeries* series, size_t first, size_t minimum, size_t maximum, size_t last)
+{
+	size_t indices[4] = { first, minimum, maximum, last };
+
+	if (indices[1] > indices[2]) {
+		size_t swap = indices[1];
+
+		indices[1] = indices[2];
+		indices[2] = swap;
+	}
+
+	for (int i = 0; i < 4; i++)
+		emitPoint(state, series, indices[i]);
+}
+
+static GskPath*
+buildPath(const OGSeries* series, size_t count, float columnWidth)
+{
+	OGPolylineState state = { gsk_path_builder_new(), false, 0, false };
+	bool columnOpen = false;
+	size_t first = 0, minimum = 0, maximum = 0, last = 0;
+	double column = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		float x = seriesX(series, i);
+		float y = series->yValues[i];
+		double pointColumn;
+
+		if (isnan(x) || isnan(y)) {
+			if (columnOpen)
+				emitColumn(&state, series, first, minimum, maximum, last);
+
+			columnOpen = false;
+			state.contourOpen = false;
+			continue;
+		}
+
+		if (columnWidth <= 0) {
+			emitPoint(&state, series, i);
+			continue;
+		}
+
+		pointColumn = floor((double)x / columnWidth);
+
+		if (columnOpen && pointColumn == column) {
+			/* Compared on the raw values, the mapping keeps the extremes. */
+			if (y < series->yValues[minimum])
+				minimum = i;
+			if (y > series->yValues[maximum])
+				maximum = i;
+			last = i;
+			continue;
+		}
+
+		if (columnOpen)
+			emitColumn(&state, series, first, minimum, maximum, last);
+
+		column = pointColumn;
+		columnOpen = true;
+		first = minimum = maximum = last = i;
+	}
+
+	if (columnOpen)
+		emitColumn(&state, series, first, minimum, maximum, last);
+
+	return gsk_path_builder_free_to_path(state.builder);
+}
+
+@implementation OGskPolylineBuilder
+
++ (GskPath*)pathWithPoints:(const graphene_point_t*)points count:(size_t)count closed:(bool)closed
+{
+	GskPathBuilder* builder;
+
+	if (points == NULL && count > 0)
+		@throw [OFInvalidArgumentException exception];
+
+	builder = gsk_path_builder_new();
+
+	if (count >= 2) {
+		gsk_path_builder_move_to(builder, points[0].x, points[0].y);
+
+		for (size_t i = 1; i < count; i++)
+			gsk_path_builder_line_to(builder, points[i].x, points[i].y);
+
+		if (closed)
+			gsk_path_builder_close(builder);
+	}
+
+	return gsk_path_builder_free_to_path(builder);
+}
+
++ (GskPath*)pathWithXValues:(const float*)xValues yValues:(const float*)yValues count:(size_t)count
+{
+	return [self decimatedPathWithXValues:xValues yValues:yValues count:count columnWidth:0];
+}
+
++ (GskPath*)decimatedPathWithXValues:(const float*)xValues yValues:(const float*)yValues count:(size_t)count columnWidth:(float)columnWidth
+{
+	OGSeries series = { xValues, yValues, 0, 0, 0, 1 };
+
+	if ((xValues == NULL || yValues == NULL) && count > 0)
+		@throw [OFInvalidArgumentException exception];
+
+	return buildPath(&series, count, columnWidth);
+}
+
++ (GskPath*)decimatedPathWithSamples:(const float*)samples count:(size_t)count bounds:(const graphene_rect_t*)bounds minimumValue:(float)minimumValue maximumValue:(float)maximumValue columnWidth:(float)columnWidth
+{
+	OGSeries series;
+	float scale;
+
+	if (bounds == NULL || (samples == NULL && count > 0) || maximumValue <= minimumValue)
+		@throw [OFInvalidArgumentException exception];
+
+	scale = bounds->size.height / (maximumValue - minimumValue);
+
+	series.xValues = NULL;
+	series.yValues = samples;
+	series.xStart = bounds->origin.x;
+	series.xStep = (count > 1 ? bounds->size.width / (float)(count - 1) : 0);
+	series.yOffset = bounds->origin.y + bounds->size.height + minimumValue * scale;
+	series.yScale = -scale;
+
+	return buildPath(&series, count, columnWidth);
+}
+
+@end
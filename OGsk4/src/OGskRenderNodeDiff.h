@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gsk/gsk.h>
+
+#import <ObjFW/ObjFW.h>
+
+/**
+ * Computes the damage between two render node trees, i.e. the area that
+ * has to be redrawn when the first tree is replaced by the second one.
+ *
+ * The trees are compared structurally. Nodes that are the same object are
+ * unchanged, so trees that reuse cached nodes, e.g. from an
+ * `OGTKRenderNodeCache`, are compared quickly. Containers are matched by
+ * their common first and last children; transforms, clips, opacity and
+ * debug nodes with equal parameters are descended into, and colors and
+ * textures are compared by value. Any other change damages the bounds of
+ * both the old and the new node, which is always correct but may be more
+ * than necessary.
+ *
+ * The result can be passed as the region to
+ * -[OGskRenderer renderWithRoot:region:].
+ */
+@interface OGskRenderNodeDiff : OFObject
+
+/**
+ * Computes the region that differs between two render node trees.
+ *
+ * @param oldNode the previous tree, or %NULL
+ * @param newNode the new tree, or %NULL
+ * @return a new region in the coordinates of the trees, which must be
+ *   destroyed with cairo_region_destroy()
+ */
++ (cairo_region_t*)regionByDiffingNode:(GskRenderNode*)oldNode withNode:(GskRenderNode*)newNode;
+
+@end
@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <math.h>
+#include <string.h>
+
+#import "OGskRenderNodeDiff.h"
+
+/*
+ * Regions with more rectangles are replaced by their extents, which is
+ * cheaper for the renderers to handle than many small clips.
+ */
+#define OG_DIFF_MAX_RECTANGLES 32
+
+static void diffNodes(GskRenderNode* oldNode, GskRenderNode* newNode, cairo_region_t* region);
+
+static void
+addRect(cairo_region_t* region, const graphene_rect_t* rect)
+{
+	cairo_rectangle_int_t rectangle;
+	float x1, y1;
+
+	if (rect->size.width <= 0 || rect->size.height <= 0)
+		return;
+
+	x1 = ceilf(rect->origin.x + rect->size.width);
+	y1 = ceilf(rect->origin.y + rect->size.height);
+	rectangle.x = (int)floorf(rect->origin.x);
+	rectangle.y = (int)floorf(rect->origin.y);
+	rectangle.width = (int)x1 - rectangle.x;
+	rectangle.height = (int)y1 - rectangle.y;
+
+	cairo_region_union_rectangle(region, &rectangle);
+}
+
+static void
+addNodeBounds(cairo_region_t* region, GskRenderNode* node)
+{
+	graphene_rect_t bounds;
+
+	if (node == NULL)
+		return;
+
+	gsk_render_node_get_bounds(node, &bounds);
+	addRect(region, &bounds);
+}
+
+static void
+addBothBounds(cairo_region_t* region, GskRenderNode* oldNode, GskRenderNode* newNode)
+{
+	addNodeBounds(region, oldNode);
+	addNodeBounds(region, newNode);
+}
+
+/*
+ * Adds the damage of two children, mapped from the child coordinates into
+ * those of the parent. Without a transform, the damage is only clipped.
+ */
+static void
+diffChildren(GskRenderNode* oldChild, GskRenderNode* newChild, GskTransform* transform, const graphene_rect_t* clip, cairo_region_t* region)
+{
+	cairo_region_t* childRegion = cairo_region_create();
+	int count;
+
+	diffNodes(oldChild, newChild, childRegion);
+	count = cairo_region_num_rectangles(childRegion);
+
+	for (int i = 0; i < count; i++) {
+		cairo_rectangle_int_t rectangle;
+		graphene_rect_t childRect, rect;
+
+		cairo_region_get_rectangle(childRegion, i, &rectangle);
+		graphene_rect_init(&childRect, rectangle.x, rectangle.y, rectangle.width, rectangle.height);
+
+		if (transform != NULL)
+			gsk_transform_transform_bounds(transform, &childRect, &rect);
+		else
+			rect = childRect;
+
+		if (clip != NULL && !graphene_rect_intersection(&rect, clip, &rect))
+			continue;
+
+		addRect(region, &rect);
+	}
+
+	cairo_region_destroy(childRegion);
+}
+
+static void
+diffContainers(GskRenderNode* oldNode, GskRenderNode* newNode, cairo_region_t* region)
+{
+	guint oldCount = gsk_container_node_get_n_children(oldNode);
+	guint newCount = gsk_container_node_get_n_children(newNode);
+	guint prefix = 0, suffix = 0;
+
+	/* Unchanged children are typically shared between both trees. */
+	while (prefix < oldCount && prefix < newCount && gsk_container_node_get_child(oldNode, prefix) == gsk_container_node_get_child(newNode, prefix))
+		prefix++;
+
+	while (suffix < oldCount - prefix && suffix < newCount - prefix && gsk_container_node_get_child(oldNode, oldCount - suffix - 1) == gsk_container_node_get_child(newNode, newCount - suffix - 1))
+		suffix++;
+
+	if (oldCount == newCount) {
+		for (guint i = prefix; i < oldCount - suffix; i++)
+			diffNodes(gsk_container_node_get_child(oldNode, i), gsk_container_node_get_child(newNode, i), region);
+
+		return;
+	}
+
+	/* Children were inserted or removed, everything in between moved. */
+	for (guint i = prefix; i < oldCount - suffix; i++)
+		addNodeBounds(region, gsk_container_node_get_child(oldNode, i));
+
+	for (guint i = prefix; i < newCount - suffix; i++)
+		addNodeBounds(region, gsk_container_node_get_child(newNode, i));
+}
+
+static void
+diffNodes(GskRenderNode* oldNode, GskRenderNode* newNode, cairo_region_t* region)
+{
+	graphene_rect_t oldBounds, newBounds;
+
+	if (oldNode == newNode)
+		return;
+
+	if (oldNode == NULL || newNode == NULL || gsk_render_node_get_node_type(oldNode) != gsk_render_node_get_node_type(newNode)) {
+		addBothBounds(region, oldNode, newNode);
+		return;
+	}
+
+	gsk_render_node_get_bounds(oldNode, &oldBounds);
+	gsk_render_node_get_bounds(newNode, &newBounds);
+
+	switch (gsk_render_node_get_node_type(oldNode)) {
+	case GSK_CONTAINER_NODE:
+		diffContainers(oldNode, newNode, region);
+		return;
+
+	case GSK_TRANSFORM_NODE: {
+		GskTransform* transform = gsk_transform_node_get_transform(oldNode);
+
+		if (!gsk_transform_equal(transform, gsk_transform_node_get_transform(newNode)))
+			break;
+
+		diffChildren(gsk_transform_node_get_child(oldNode), gsk_transform_node_get_child(newNode), transform, NULL, region);
+		return;
+	}
+
+	case GSK_CLIP_NODE: {
+		const graphene_rect_t* clip = gsk_clip_node_get_clip(oldNode);
+
+		if (!graphene_rect_equal(clip, gsk_clip_node_get_clip(newNode)))
+			break;
+
+		diffChildren(gsk_clip_node_get_child(oldNode), gsk_clip_node_get_child(newNode), NULL, clip, region);
+		return;
+	}
+
+	case GSK_ROUNDED_CLIP_NODE: {
+		const GskRoundedRect* clip = gsk_rounded_clip_node_get_clip(oldNode);
+
+		if (memcmp(clip, gsk_rounded_clip_node_get_clip(newNode), sizeof(*clip)) != 0)
+			break;
+
+		diffChildren(gsk_rounded_clip_node_get_child(oldNode), gsk_rounded_clip_node_get_child(newNode), NULL, &clip->bounds, region);
+		return;
+	}
+
+	case GSK_OPACITY_NODE:
+		if (gsk_opacity_node_get_opacity(oldNode) != gsk_opacity_node_get_opacity(newNode))
+			break;
+
+		diffNodes(gsk_opacity_node_get_child(oldNode), gsk_opacity_node_get_child(newNode), region);
+		return;
+
+	case GSK_DEBUG_NODE:
+		diffNodes(gsk_debug_node_get_child(oldNode), gsk_debug_node_get_child(newNode), region);
+		return;
+
+	case GSK_COLOR_NODE:
+		if (graphene_rect_equal(&oldBounds, &newBounds) && gdk_rgba_equal(gsk_color_node_get_color(oldNode), gsk_color_node_get_color(newNode)))
+			return;
+		break;
+
+	case GSK_TEXTURE_NODE:
+		if (graphene_rect_equal(&oldBounds, &newBounds) && gsk_texture_node_get_texture(oldNode) == gsk_texture_node_get_texture(newNode))
+			return;
+		break;
+
+	default:
+		break;
+	}
+
+	addRect(region, &oldBounds);
+	addRect(region, &newBounds);
+}
+
+@implementation OGskRenderNodeDiff
+
++ (cairo_region_t*)regionByDiffingNode:(GskRenderNode*)oldNode withNode:(GskRenderNode*)newNode
+{
+	cairo_region_t* region = cairo_region_create();
+
+	diffNodes(oldNode, newNode, region);
+
+	if (cairo_region_num_rectangles(region) > OG_DIFF_MAX_RECTANGLES) {
+		cairo_rectangle_int_t extents;
+
+		cairo_region_get_extents(region, &extents);
+		cairo_region_destroy(region);
+		region = cairo_region_create_rectangle(&extents);
+	}
+
+	return region;
+}
+
+@end
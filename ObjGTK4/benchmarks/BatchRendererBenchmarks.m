@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import <OGdk4/OGdkTexture.h>
+#import <OGsk4/OGskBatchRenderer.h>
+#import <OGsk4/OGskCairoRenderer.h>
+
+#import "OGTKSnapshot.h"
+
+#import "Benchmarks.h"
+
+#define OG_BENCHMARK_CHART_COUNT 200
+#define OG_BENCHMARK_CHART_WIDTH 640
+#define OG_BENCHMARK_CHART_HEIGHT 400
+#define OG_BENCHMARK_CHART_BARS 64
+
+/* A bar chart preview, built like an application would build it. */
+static GskRenderNode*
+newChartNode(unsigned int seed)
+{
+	OGTKSnapshot* snapshot = [OGTKSnapshot snapshot];
+	graphene_rect_t bounds = GRAPHENE_RECT_INIT(0, 0, OG_BENCHMARK_CHART_WIDTH, OG_BENCHMARK_CHART_HEIGHT);
+	GdkRGBA background = { 0.98f, 0.98f, 0.96f, 1 };
+	float barWidth = (float)OG_BENCHMARK_CHART_WIDTH / OG_BENCHMARK_CHART_BARS;
+	GskRoundedRect clip;
+
+	gsk_rounded_rect_init_from_rect(&clip, &bounds, 12);
+	[snapshot pushRoundedClipWithBounds:&clip];
+	[snapshot appendColor:&background bounds:&bounds];
+
+	for (unsigned int i = 0; i < OG_BENCHMARK_CHART_BARS; i++) {
+		float height = (float)((seed * 7919 + i * 104729) % (OG_BENCHMARK_CHART_HEIGHT - 40)) + 20;
+		graphene_rect_t bar = GRAPHENE_RECT_INIT(i * barWidth + 1, OG_BENCHMARK_CHART_HEIGHT - height, barWidth - 2, height);
+		GdkRGBA color = { 0.2f, 0.4f + 0.5f * i / OG_BENCHMARK_CHART_BARS, 0.8f, 0.9f };
+
+		[snapshot appendColor:&color bounds:&bar];
+	}
+
+	[snapshot pop];
+
+	return [snapshot toNode];
+}
+
+/*
+ * Rendering chart previews to PNG without a display, on one renderer on
+ * the calling thread and on batch renderers with more and more renderers.
+ */
+void
+OGBenchmarkBatchRenderer(void)
+{
+#ifdef OF_HAVE_BLOCKS
+	GskRenderNode* nodes[OG_BENCHMARK_CHART_COUNT];
+	OGskCairoRenderer* renderer;
+	gint64 start;
+
+	for (unsigned int i = 0; i < OG_BENCHMARK_CHART_COUNT; i++)
+		nodes[i] = newChartNode(i);
+
+	@try {
+		renderer = [OGskCairoRenderer cairoRenderer];
+		if (![renderer realizeWithSurface:nil])
+			@throw [OFInitializationFailedException exceptionWithClass:[OGskCairoRenderer class]];
+
+		@try {
+			start = g_get_monotonic_time();
+			for (unsigned int i = 0; i < OG_BENCHMARK_CHART_COUNT; i++) {
+				void* pool = objc_autoreleasePoolPush();
+				GBytes* pngBytes = [[renderer renderTextureWithRoot:nodes[i] viewport:NULL] saveToPngBytes];
+
+				g_bytes_unref(pngBytes);
+				objc_autoreleasePoolPop(pool);
+			}
+			OGBenchmarkReport(@"rendering: charts to PNG, one renderer", OG_BENCHMARK_CHART_COUNT, g_get_monotonic_time() - start);
+		} @finally {
+			[renderer unrealize];
+		}
+
+		for (unsigned int rendererCount = 1; rendererCount != 0; rendererCount = OGBenchmarkNextThreadCount(rendererCount)) {
+			void* pool = objc_autoreleasePoolPush();
+			OGskBatchRenderer* batchRenderer = [OGskBatchRenderer batchRendererWithDisplay:nil rendererCount:rendererCount];
+			OGskBatchRenderStatistics statistics;
+
+			start = g_get_monotonic_time();
+			for (unsigned int i = 0; i < OG_BENCHMARK_CHART_COUNT; i++)
+				[batchRenderer renderNode:nodes[i] viewport:NULL encodeToPng:true completionHandler:^(OGdkTexture* texture, GBytes* pngBytes) {}];
+			[batchRenderer waitUntilAllRendered];
+			OGBenchmarkReport([OFString stringWithFormat:@"rendering: charts to PNG, %u renderers", rendererCount], OG_BENCHMARK_CHART_COUNT, g_get_monotonic_time() - start);
+
+			statistics = [batchRenderer statistics];
+			[OFStdOut writeFormat:@"rendering:   %.2f ms rendering and %.2f ms encoding per chart\n", statistics.renderTime / 1000.0 / OG_BENCHMARK_CHART_COUNT, statistics.encodeTime / 1000.0 / OG_BENCHMARK_CHART_COUNT];
+
+			objc_autoreleasePoolPop(pool);
+		}
+	} @finally {
+		for (unsigned int i = 0; i < OG_BENCHMARK_CHART_COUNT; i++)
+			gsk_render_node_unref(nodes[i]);
+	}
+#else
+	[OFStdOut writeLine:@"rendering: skipped, needs blocks"];
+#endif
+}
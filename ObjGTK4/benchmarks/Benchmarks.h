@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <glib.h>
+
+#import <ObjFW/ObjFW.h>
+
+/**
+ * Prints the time a measurement took and the resulting throughput.
+ *
+ * @param name the name of the measurement
+ * @param items the number of items processed
+ * @param microseconds the time the measurement took
+ */
+extern void OGBenchmarkReport(OFString* name, size_t items, gint64 microseconds);
+
+/**
+ * Steps through thread counts of 1, 2, 4, … up to and including the number
+ * of processors.
+ *
+ * @param threadCount the previous thread count
+ * @return the next thread count, or 0 after the number of processors
+ */
+extern unsigned int OGBenchmarkNextThreadCount(unsigned int threadCount);
+
+extern void OGBenchmarkPango(void);
+extern void OGBenchmarkPixelConverter(void);
+extern void OGBenchmarkPixbufScaling(void);
+extern void OGBenchmarkBatchRenderer(void);
+extern void OGBenchmarkSnapshot(void);
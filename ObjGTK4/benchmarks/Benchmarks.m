@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <string.h>
+
+#import "Benchmarks.h"
+
+/*
+ * Benchmarks for the parallel and batched paths of the libraries, each
+ * compared to the serial or per-item path it replaces. Pass the names of
+ * the benchmarks to run, or none to run all of them.
+ */
+static const struct {
+	const char* name;
+	void (*run)(void);
+} benchmarks[] = {
+	{ "pango", OGBenchmarkPango },
+	{ "pixels", OGBenchmarkPixelConverter },
+	{ "scaling", OGBenchmarkPixbufScaling },
+	{ "rendering", OGBenchmarkBatchRenderer },
+	{ "snapshot", OGBenchmarkSnapshot },
+};
+
+void
+OGBenchmarkReport(OFString* name, size_t items, gint64 microseconds)
+{
+	double seconds = (double)MAX(microseconds, 1) / G_USEC_PER_SEC;
+
+	[OFStdOut writeFormat:@"%-56s %10.2f ms %14.0f/s\n", [name UTF8String], microseconds / 1000.0, items / seconds];
+}
+
+unsigned int
+OGBenchmarkNextThreadCount(unsigned int threadCount)
+{
+	unsigned int processors = g_get_num_processors();
+
+	if (threadCount >= processors)
+		return 0;
+
+	return MIN(threadCount * 2, processors);
+}
+
+int
+main(int argc, char* argv[])
+{
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(*benchmarks); i++) {
+		bool selected = (argc < 2);
+		void* pool;
+
+		for (int j = 1; j < argc && !selected; j++)
+			selected = (strcmp(argv[j], benchmarks[i].name) == 0);
+
+		if (!selected)
+			continue;
+
+		pool = objc_autoreleasePoolPush();
+		benchmarks[i].run();
+		objc_autoreleasePoolPop(pool);
+	}
+
+	return 0;
+}
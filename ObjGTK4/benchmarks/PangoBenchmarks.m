@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <pango/pangocairo.h>
+
+#import <OGPango/OGPangoFontMap.h>
+#import <OGPango/OGPangoTextMeasurer.h>
+
+#import "Benchmarks.h"
+
+#define OG_BENCHMARK_STRING_COUNT 100000
+
+static const char* const words[] = {
+	"lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing",
+	"elit", "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore"
+};
+
+/* Sizing column cells: 100k short strings of different lengths. */
+void
+OGBenchmarkPango(void)
+{
+	PangoFontMap* gFontMap = pango_cairo_font_map_new();
+	PangoFontDescription* desc = pango_font_description_from_string("Sans 11");
+	OFMutableArray OF_GENERIC(OFString*)* texts = [OFMutableArray arrayWithCapacity:OG_BENCHMARK_STRING_COUNT];
+	int* widths = g_new(int, OG_BENCHMARK_STRING_COUNT);
+	int* heights = g_new(int, OG_BENCHMARK_STRING_COUNT);
+	OGPangoFontMap* fontMap;
+
+	@try {
+		PangoContext* context;
+		PangoLayout* layout;
+		gint64 start;
+
+		fontMap = OGWrapperClassAndObjectForGObject(gFontMap);
+
+		for (size_t i = 0; i < OG_BENCHMARK_STRING_COUNT; i++) {
+			size_t wordCount = 1 + i % 6;
+			OFMutableString* text = [OFMutableString stringWithFormat:@"%zu", i];
+
+			for (size_t j = 0; j < wordCount; j++)
+				[text appendFormat:@" %s", words[(i + j * 7) % (sizeof(words) / sizeof(*words))]];
+
+			[texts addObject:text];
+		}
+
+		context = pango_font_map_create_context(gFontMap);
+		layout = pango_layout_new(context);
+		pango_layout_set_font_description(layout, desc);
+
+		/* Every run after this one finds the glyphs cached. */
+		start = g_get_monotonic_time();
+		for (size_t i = 0; i < OG_BENCHMARK_STRING_COUNT; i++) {
+			PangoRectangle logicalRect;
+
+			pango_layout_set_text(layout, [[texts objectAtIndex:i] UTF8String], -1);
+			pango_layout_get_pixel_extents(layout, NULL, &logicalRect);
+
+			widths[i] = logicalRect.width;
+			heights[i] = logicalRect.height;
+		}
+		OGBenchmarkReport(@"pango: PangoLayout, first run", OG_BENCHMARK_STRING_COUNT, g_get_monotonic_time() - start);
+
+		start = g_get_monotonic_time();
+		for (size_t i = 0; i < OG_BENCHMARK_STRING_COUNT; i++) {
+			PangoRectangle logicalRect;
+
+			pango_layout_set_text(layout, [[texts objectAtIndex:i] UTF8String], -1);
+			pango_layout_get_pixel_extents(layout, NULL, &logicalRect);
+
+			widths[i] = logicalRect.width;
+			heights[i] = logicalRect.height;
+		}
+		OGBenchmarkReport(@"pango: PangoLayout on the calling thread", OG_BENCHMARK_STRING_COUNT, g_get_monotonic_time() - start);
+
+		g_object_unref(layout);
+		g_object_unref(context);
+
+		for (unsigned int threadCount = 1; threadCount != 0; threadCount = OGBenchmarkNextThreadCount(threadCount)) {
+			void* pool = objc_autoreleasePoolPush();
+			OGPangoTextMeasurer* measurer = [OGPangoTextMeasurer measurerWithFontMap:fontMap threadCount:threadCount];
+
+			start = g_get_monotonic_time();
+			[measurer measureTexts:texts fontDescription:desc width:-1 wrap:PANGO_WRAP_WORD widths:widths heights:heights baselines:NULL];
+			OGBenchmarkReport([OFString stringWithFormat:@"pango: OGPangoTextMeasurer, %u threads", threadCount], OG_BENCHMARK_STRING_COUNT, g_get_monotonic_time() - start);
+
+			objc_autoreleasePoolPop(pool);
+		}
+	} @finally {
+		g_free(heights);
+		g_free(widths);
+		pango_font_description_free(desc);
+		g_object_unref(gFontMap);
+	}
+}
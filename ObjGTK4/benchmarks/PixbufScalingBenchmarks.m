@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <string.h>
+
+#import <OGdkPixbuf/OGdkPixbuf.h>
+#import <OGdkPixbuf/OGdkPixbuf+OGParallelScaling.h>
+
+#import "Benchmarks.h"
+
+/* A 40 megapixel photo scaled down for display. */
+#define OG_BENCHMARK_SOURCE_WIDTH 7728
+#define OG_BENCHMARK_SOURCE_HEIGHT 5152
+#define OG_BENCHMARK_DEST_WIDTH 1932
+#define OG_BENCHMARK_DEST_HEIGHT 1288
+
+static bool
+pixbufsEqual(OGdkPixbuf* a, OGdkPixbuf* b)
+{
+	GdkPixbuf* gA = [a castedGObject];
+	GdkPixbuf* gB = [b castedGObject];
+	size_t rowLength = (size_t)gdk_pixbuf_get_width(gA) * gdk_pixbuf_get_n_channels(gA);
+
+	for (int y = 0; y < gdk_pixbuf_get_height(gA); y++)
+		if (memcmp(gdk_pixbuf_read_pixels(gA) + (size_t)y * gdk_pixbuf_get_rowstride(gA), gdk_pixbuf_read_pixels(gB) + (size_t)y * gdk_pixbuf_get_rowstride(gB), rowLength) != 0)
+			return false;
+
+	return true;
+}
+
+void
+OGBenchmarkPixbufScaling(void)
+{
+	OGdkPixbuf* source = [OGdkPixbuf pixbufWithColorspace:GDK_COLORSPACE_RGB hasAlpha:false bitsPerSample:8 width:OG_BENCHMARK_SOURCE_WIDTH height:OG_BENCHMARK_SOURCE_HEIGHT];
+	GdkPixbuf* gSource = [source castedGObject];
+	guint8* pixels = gdk_pixbuf_get_pixels(gSource);
+	int rowstride = gdk_pixbuf_get_rowstride(gSource);
+	OGdkPixbuf* serial;
+	gint64 start;
+
+	for (int y = 0; y < OG_BENCHMARK_SOURCE_HEIGHT; y++)
+		for (int x = 0; x < OG_BENCHMARK_SOURCE_WIDTH * 3; x++)
+			pixels[(size_t)y * rowstride + x] = (guint8)(x ^ y);
+
+	start = g_get_monotonic_time();
+	serial = [source scaleSimpleWithDestWidth:OG_BENCHMARK_DEST_WIDTH destHeight:OG_BENCHMARK_DEST_HEIGHT interpType:GDK_INTERP_BILINEAR];
+	OGBenchmarkReport(@"scaling: 40 MP to 2.5 MP, serial", 1, g_get_monotonic_time() - start);
+
+	for (unsigned int threadCount = 1; threadCount != 0; threadCount = OGBenchmarkNextThreadCount(threadCount)) {
+		void* pool = objc_autoreleasePoolPush();
+		OGdkPixbuf* parallel;
+
+		start = g_get_monotonic_time();
+		parallel = [source scaleSimpleWithDestWidth:OG_BENCHMARK_DEST_WIDTH destHeight:OG_BENCHMARK_DEST_HEIGHT interpType:GDK_INTERP_BILINEAR threadCount:threadCount];
+		OGBenchmarkReport([OFString stringWithFormat:@"scaling: 40 MP to 2.5 MP, %u threads", threadCount], 1, g_get_monotonic_time() - start);
+
+		if (!pixbufsEqual(serial, parallel))
+			[OFStdOut writeFormat:@"scaling: result with %u threads differs from the serial one\n", threadCount];
+
+		objc_autoreleasePoolPop(pool);
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gdk/gdk.h>
+
+#import <OGdk4/OGdkPixelConverter.h>
+
+#import "Benchmarks.h"
+
+#define OG_BENCHMARK_FRAME_WIDTH 1920
+#define OG_BENCHMARK_FRAME_HEIGHT 1080
+#define OG_BENCHMARK_FRAME_COUNT 100
+
+static const struct {
+	const char* name;
+	GdkMemoryFormat format;
+	size_t bytesPerPixel;
+} sourceFormats[] = {
+	{ "RGB", GDK_MEMORY_R8G8B8, 3 },
+	{ "BGRA", GDK_MEMORY_B8G8R8A8, 4 },
+	{ "RGBA16", GDK_MEMORY_R16G16B16A16, 8 }
+};
+
+/*
+ * Converting 1080p camera frames into premultiplied RGBA for a memory
+ * texture, compared to wrapping them in a texture and downloading that in
+ * the target format.
+ */
+void
+OGBenchmarkPixelConverter(void)
+{
+	size_t destinationStride = OG_BENCHMARK_FRAME_WIDTH * 4;
+	guint8* destination = g_malloc(destinationStride * OG_BENCHMARK_FRAME_HEIGHT);
+
+	[OFStdOut writeFormat:@"pixels: converter implementation: %@\n", [OGdkPixelConverter implementationName]];
+
+	for (size_t i = 0; i < sizeof(sourceFormats) / sizeof(*sourceFormats); i++) {
+		size_t sourceStride = OG_BENCHMARK_FRAME_WIDTH * sourceFormats[i].bytesPerPixel;
+		size_t sourceLength = sourceStride * OG_BENCHMARK_FRAME_HEIGHT;
+		guint8* source = g_malloc(sourceLength);
+		GBytes* sourceBytes;
+		gint64 start;
+
+		for (size_t j = 0; j < sourceLength; j++)
+			source[j] = (guint8)(j * 31 + (j >> 8));
+
+		sourceBytes = g_bytes_new_static(source, sourceLength);
+
+		start = g_get_monotonic_time();
+		for (int frame = 0; frame < OG_BENCHMARK_FRAME_COUNT; frame++) {
+			GdkTexture* texture = gdk_memory_texture_new(OG_BENCHMARK_FRAME_WIDTH, OG_BENCHMARK_FRAME_HEIGHT, sourceFormats[i].format, sourceBytes, sourceStride);
+			GdkTextureDownloader* downloader = gdk_texture_downloader_new(texture);
+
+			gdk_texture_downloader_set_format(downloader, GDK_MEMORY_R8G8B8A8_PREMULTIPLIED);
+			gdk_texture_downloader_download_into(downloader, destination, destinationStride);
+
+			gdk_texture_downloader_free(downloader);
+			g_object_unref(texture);
+		}
+		OGBenchmarkReport([OFString stringWithFormat:@"pixels: %s frames, texture download", sourceFormats[i].name], OG_BENCHMARK_FRAME_COUNT, g_get_monotonic_time() - start);
+
+		start = g_get_monotonic_time();
+		for (int frame = 0; frame < OG_BENCHMARK_FRAME_COUNT; frame++)
+			[OGdkPixelConverter convertPixels:source format:sourceFormats[i].format stride:sourceStride toPixels:destination format:GDK_MEMORY_R8G8B8A8_PREMULTIPLIED stride:destinationStride width:OG_BENCHMARK_FRAME_WIDTH height:OG_BENCHMARK_FRAME_HEIGHT];
+		OGBenchmarkReport([OFString stringWithFormat:@"pixels: %s frames, OGdkPixelConverter", sourceFormats[i].name], OG_BENCHMARK_FRAME_COUNT, g_get_monotonic_time() - start);
+
+		g_bytes_unref(sourceBytes);
+		g_free(source);
+	}
+
+	g_free(destination);
+}
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import <OGdk4/OGdkTexture.h>
+
+#import "OGTKSnapshot.h"
+#import "OGTKSnapshot+OGBatchedPrimitives.h"
+
+#import "Benchmarks.h"
+
+#define OG_BENCHMARK_PRIMITIVE_COUNT 100000
+
+typedef void (*OGBenchmarkAppendFunction)(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture);
+
+static void
+appendColorsOneByOne(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture)
+{
+	for (size_t i = 0; i < OG_BENCHMARK_PRIMITIVE_COUNT; i++)
+		[snapshot appendColor:&colors[i] bounds:&rects[i]];
+}
+
+static void
+appendColorsBatched(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture)
+{
+	[snapshot appendColors:colors rects:rects count:OG_BENCHMARK_PRIMITIVE_COUNT];
+}
+
+static void
+appendColorBatched(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture)
+{
+	[snapshot appendColor:&colors[0] rects:rects count:OG_BENCHMARK_PRIMITIVE_COUNT];
+}
+
+static void
+appendTexturesOneByOne(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture)
+{
+	for (size_t i = 0; i < OG_BENCHMARK_PRIMITIVE_COUNT; i++)
+		[snapshot appendTexture:texture bounds:&rects[i]];
+}
+
+static void
+appendTexturesBatched(OGTKSnapshot* snapshot, const GdkRGBA* colors, const graphene_rect_t* rects, GdkTexture* const* textures, OGdkTexture* texture)
+{
+	[snapshot appendTextures:textures rects:rects count:OG_BENCHMARK_PRIMITIVE_COUNT];
+}
+
+static const struct {
+	const char* name;
+	OGBenchmarkAppendFunction append;
+} appendFunctions[] = {
+	{ "-appendColor:bounds: per rect", appendColorsOneByOne },
+	{ "-appendColors:rects:count:", appendColorsBatched },
+	{ "-appendColor:rects:count:", appendColorBatched },
+	{ "-appendTexture:bounds: per rect", appendTexturesOneByOne },
+	{ "-appendTextures:rects:count:", appendTexturesBatched }
+};
+
+/* Building the nodes of a scatter plot with 100k points, up to -toNode. */
+void
+OGBenchmarkSnapshot(void)
+{
+	GdkRGBA* colors = g_new(GdkRGBA, OG_BENCHMARK_PRIMITIVE_COUNT);
+	graphene_rect_t* rects = g_new(graphene_rect_t, OG_BENCHMARK_PRIMITIVE_COUNT);
+	GdkTexture** textures = g_new(GdkTexture*, OG_BENCHMARK_PRIMITIVE_COUNT);
+	guint8 pixels[4 * 4 * 4] = { 0 };
+	GBytes* bytes = g_bytes_new(pixels, sizeof(pixels));
+	GdkTexture* gTexture = gdk_memory_texture_new(4, 4, GDK_MEMORY_R8G8B8A8_PREMULTIPLIED, bytes, 4 * 4);
+
+	g_bytes_unref(bytes);
+
+	@try {
+		OGdkTexture* texture = OGWrapperClassAndObjectForGObject(gTexture);
+
+		for (size_t i = 0; i < OG_BENCHMARK_PRIMITIVE_COUNT; i++) {
+			float x = (float)(i % 400) * 2.5f, y = (float)((i * 7) % 1000);
+
+			colors[i] = (GdkRGBA){ (float)(i % 256) / 255, 0.5f, 0.8f, 1 };
+			rects[i] = GRAPHENE_RECT_INIT(x, y, 2, 2);
+			textures[i] = gTexture;
+		}
+
+		for (size_t i = 0; i < sizeof(appendFunctions) / sizeof(*appendFunctions); i++) {
+			void* pool = objc_autoreleasePoolPush();
+			OGTKSnapshot* snapshot = [OGTKSnapshot snapshot];
+			GskRenderNode* node;
+			gint64 start;
+
+			start = g_get_monotonic_time();
+			appendFunctions[i].append(snapshot, colors, rects, textures, texture);
+			node = [snapshot toNode];
+			OGBenchmarkReport([OFString stringWithFormat:@"snapshot: 100k primitives, %s", appendFunctions[i].name], OG_BENCHMARK_PRIMITIVE_COUNT, g_get_monotonic_time() - start);
+
+			gsk_render_node_unref(node);
+			objc_autoreleasePoolPop(pool);
+		}
+	} @finally {
+		g_object_unref(gTexture);
+		g_free(textures);
+		g_free(rects);
+		g_free(colors);
+	}
+}
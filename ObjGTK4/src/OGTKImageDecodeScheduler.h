@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGCancellable;
+@class OGdkTexture;
+@class OGTKImageDecodeScheduler;
+@class OGTKListItem;
+@class OGTKPicture;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block which is called once an image has been decoded.
+ *
+ * It is not called for requests that were cancelled.
+ *
+ * @param texture the decoded image, or %nil if it could not be loaded
+ * @param error the error that occurred while loading the image, or %NULL
+ */
+typedef void (^OGTKImageDecodeCompletionHandler)(OGdkTexture* texture, const GError* error);
+#endif
+
+/**
+ * A request for an image scheduled on an `OGTKImageDecodeScheduler`.
+ */
+@interface OGTKImageDecodeRequest : OFObject
+{
+	OGTKImageDecodeScheduler* _scheduler;
+	OFString* _filename;
+	int _width;
+	int _height;
+	int _decodeWidth;
+	int _decodeHeight;
+#ifdef OF_HAVE_BLOCKS
+	OGTKImageDecodeCompletionHandler _handler;
+#endif
+	OGCancellable* _cancellable;
+	GtkListItem* _listItem;
+	gpointer _boundItem;
+	gulong _notifyHandlerID;
+	unsigned long long _sequence;
+	bool _visible;
+	bool _running;
+	bool _finished;
+}
+
+/**
+ * Methods
+ */
+
+/**
+ * The path of the image file.
+ *
+ * @return the path of the image file
+ */
+- (OFString*)filename;
+
+/**
+ * Whether the request is boosted because its image is currently visible.
+ *
+ * @return whether the request is visible
+ */
+- (bool)isVisible;
+
+/**
+ * Sets whether the image of the request is currently visible.
+ *
+ * Visible requests are started before all invisible ones, newer requests
+ * before older ones. Requests are visible when they are created.
+ *
+ * @param visible whether the image is visible
+ */
+- (void)setVisible:(bool)visible;
+
+/**
+ * Whether the request has completed or was cancelled.
+ *
+ * @return whether the request is finished
+ */
+- (bool)isFinished;
+
+/**
+ * Cancels the request.
+ *
+ * A pending request is removed from the queue, a running decode is aborted
+ * through its `OGCancellable`. The completion handler is not called.
+ */
+- (void)cancel;
+
+@end
+
+/**
+ * An `OGTKImageDecodeScheduler` decodes image files into textures with a
+ * bounded number of decodes in flight.
+ *
+ * Scrolling a `GtkGridView` of images requests far more images than can be
+ * decoded in time. Instead of starting all of them at once, which floods the
+ * thread pool of GIO, the scheduler queues the requests and only starts a
+ * limited number of them. Requests for visible images are started first,
+ * and among those the most recent ones, as these are the images the user is
+ * looking at right now.
+ *
+ * A decode queries the size of the image with
+ * +[OGdkPixbuf fileInfoAsyncWithFilename:cancellable:callback:userData:],
+ * then opens the file and decodes it with
+ * +[OGdkPixbuf newFromStreamAtScaleAsync:width:height:preserveAspectRatio:cancellable:callback:userData:],
+ * scaling it down to the requested size. Images are never scaled up.
+ *
+ * Requests that are bound to a `GtkListItem` are cancelled automatically
+ * when the list item is unbound or rebound to another item.
+ *
+ * The scheduler must only be used from the thread that created it, and that
+ * thread must run its thread-default main context.
+ */
+@interface OGTKImageDecodeScheduler : OFObject
+{
+	unsigned int _maxConcurrentDecodes;
+	OFMutableArray OF_GENERIC(OGTKImageDecodeRequest*)* _pendingRequests;
+	OFMutableArray OF_GENERIC(OGTKImageDecodeRequest*)* _runningRequests;
+	unsigned long long _nextSequence;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)schedulerWithMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes;
+
+/**
+ * Initializes a decode scheduler.
+ *
+ * @param maxConcurrentDecodes the maximum number of images decoded at the
+ *   same time, or 0 to use the number of processors
+ * @return an initialized decode scheduler
+ */
+- (instancetype)initWithMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes;
+
+/**
+ * Methods
+ */
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Schedules decoding an image file.
+ *
+ * The image is scaled down to fit into the requested dimensions, preserving
+ * its aspect ratio. The handler is called on the main context of the thread
+ * that created the scheduler.
+ *
+ * @param filename the path of the image file
+ * @param width the maximum width of the texture in pixels, or -1
+ * @param height the maximum height of the texture in pixels, or -1
+ * @param listItem a list item whose unbinding cancels the request, or %nil
+ * @param handler the block to call with the texture
+ * @return the scheduled request
+ */
+- (OGTKImageDecodeRequest*)decodeFilename:(OFString*)filename width:(int)width height:(int)height listItem:(OGTKListItem*)listItem completionHandler:(OGTKImageDecodeCompletionHandler)handler;
+
+/**
+ * Schedules decoding an image file into a picture.
+ *
+ * The image is decoded at the allocated size of the picture multiplied by
+ * its scale factor, or at its natural size if the picture is not allocated
+ * yet, and set as paintable of the picture once it is available.
+ *
+ * @param filename the path of the image file
+ * @param picture the picture to show the image in
+ * @param listItem a list item whose unbinding cancels the request, or %nil
+ * @return the scheduled request
+ */
+- (OGTKImageDecodeRequest*)decodeFilename:(OFString*)filename intoPicture:(OGTKPicture*)picture listItem:(OGTKListItem*)listItem;
+#endif
+
+/**
+ * Cancels all pending and running requests.
+ */
+- (void)cancelAllRequests;
+
+/**
+ * The maximum number of images decoded at the same time.
+ *
+ * @return the maximum number of concurrent decodes
+ */
+- (unsigned int)maxConcurrentDecodes;
+
+/**
+ * Sets the maximum number of images decoded at the same time.
+ *
+ * Lowering the limit does not abort running decodes.
+ *
+ * @param maxConcurrentDecodes the maximum number of concurrent decodes, at
+ *   least 1
+ */
+- (void)setMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes;
+
+/**
+ * The number of requests waiting to be started.
+ *
+ * @return the number of pending requests
+ */
+- (size_t)pendingCount;
+
+/**
+ * The number of decodes in flight, including cancelled decodes that have not
+ * returned yet.
+ *
+ * @return the number of running decodes
+ */
+- (size_t)runningCount;
+
+@end
@@ -0,0 +1,485 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKImageDecodeScheduler.h"
+
+#import <OGdk4/OGdkTexture.h>
+#import <OGdkPixbuf/OGdkPixbuf.h>
+#import <OGio/OGCancellable.h>
+#import <OGio/OGInputStream.h>
+
+#import "OGTKListItem.h"
+#import "OGTKPicture.h"
+
+@interface OGTKImageDecodeScheduler ()
+- (unsigned long long)og_nextSequence;
+- (void)og_removePendingRequest:(OGTKImageDecodeRequest*)request;
+- (void)og_requestDidStop:(OGTKImageDecodeRequest*)request;
+- (void)og_startPendingRequests;
+@end
+
+@interface OGTKImageDecodeRequest ()
+#ifdef OF_HAVE_BLOCKS
+- (instancetype)og_initWithScheduler:(OGTKImageDecodeScheduler*)scheduler filename:(OFString*)filename width:(int)width height:(int)height listItem:(OGTKListItem*)listItem handler:(OGTKImageDecodeCompletionHandler)handler;
+#endif
+- (unsigned long long)og_sequence;
+- (void)og_start;
+- (void)og_fileInfoDidLoad:(GAsyncResult*)result;
+- (void)og_fileDidOpen:(GFile*)file result:(GAsyncResult*)result;
+- (void)og_pixbufDidLoad:(GAsyncResult*)result;
+- (void)og_completeWithTexture:(OGdkTexture*)texture error:(const GError*)error;
+- (void)og_listItemDidChange;
+- (void)og_detachFromScheduler;
+- (void)og_finish;
+@end
+
+static void
+fileInfoReady(GObject* source, GAsyncResult* result, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+
+	[(OGTKImageDecodeRequest*)userData og_fileInfoDidLoad:result];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static void
+fileOpened(GObject* source, GAsyncResult* result, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+
+	[(OGTKImageDecodeRequest*)userData og_fileDidOpen:G_FILE(source) result:result];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static void
+pixbufReady(GObject* source, GAsyncResult* result, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+
+	[(OGTKImageDecodeRequest*)userData og_pixbufDidLoad:result];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static void
+listItemItemChanged(GObject* object, GParamSpec* pspec, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+
+	[(OGTKImageDecodeRequest*)userData og_listItemDidChange];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+@implementation OGTKImageDecodeRequest
+
+- (instancetype)init
+{
+	OF_INVALID_INIT_METHOD
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (instancetype)og_initWithScheduler:(OGTKImageDecodeScheduler*)scheduler filename:(OFString*)filename width:(int)width height:(int)height listItem:(OGTKListItem*)listItem handler:(OGTKImageDecodeCompletionHandler)handler
+{
+	self = [super init];
+
+	@try {
+		if (filename == nil || handler == nil)
+			@throw [OFInvalidArgumentException exception];
+
+		_scheduler = scheduler;
+		_filename = [filename copy];
+		_width = width;
+		_height = height;
+		_handler = [handler copy];
+		_cancellable = [[OGCancellable cancellable] retain];
+		_sequence = [scheduler og_nextSequence];
+		_visible = true;
+
+		if (listItem != nil) {
+			_listItem = g_object_ref([listItem castedGObject]);
+			_boundItem = gtk_list_item_get_item(_listItem);
+			_notifyHandlerID = g_signal_connect(_listItem, "notify::item", G_CALLBACK(listItemItemChanged), self);
+		}
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+#endif
+
+- (void)dealloc
+{
+	[self og_finish];
+	[_filename release];
+	[_cancellable release];
+
+	[super dealloc];
+}
+
+- (OFString*)filename
+{
+	return _filename;
+}
+
+- (bool)isVisible
+{
+	return _visible;
+}
+
+- (void)setVisible:(bool)visible
+{
+	/* A request that becomes visible again counts as a new request. */
+	if (visible && !_visible && _scheduler != nil)
+		_sequence = [_scheduler og_nextSequence];
+
+	_visible = visible;
+}
+
+- (bool)isFinished
+{
+	return _finished;
+}
+
+- (void)cancel
+{
+	if (_finished)
+		return;
+
+	[self retain];
+	@try {
+		[_cancellable cancel];
+
+		/*
+		 * A running decode keeps its slot until GIO reports the
+		 * cancellation, so the limit also covers aborted decodes.
+		 */
+		if (!_running)
+			[_scheduler og_removePendingRequest:self];
+
+		[self og_finish];
+	} @finally {
+		[self release];
+	}
+}
+
+- (unsigned long long)og_sequence
+{
+	return _sequence;
+}
+
+- (void)og_start
+{
+	_running = true;
+
+	/* Balanced in -og_completeWithTexture:error:. */
+	[self retain];
+	[_scheduler retain];
+
+	[OGdkPixbuf fileInfoAsyncWithFilename:_filename cancellable:_cancellable callback:fileInfoReady userData:self];
+}
+
+- (void)og_fileInfoDidLoad:(GAsyncResult*)result
+{
+	GError* err = NULL;
+	int width, height, naturalWidth = 0, naturalHeight = 0;
+	GFile* file;
+
+	if (gdk_pixbuf_get_file_info_finish(result, &naturalWidth, &naturalHeight, &err) == NULL) {
+		if (err == NULL)
+			g_set_error_literal(&err, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_UNKNOWN_TYPE, "Unrecognized image file format");
+
+		[self og_completeWithTexture:nil error:err];
+		g_error_free(err);
+		return;
+	}
+
+	if (_finished) {
+		[self og_completeWithTexture:nil error:NULL];
+		return;
+	}
+
+	width = _width;
+	height = _height;
+
+	/* Decode images that already fit at their natural size. */
+	if ((width < 0 || naturalWidth <= width) && (height < 0 || naturalHeight <= height))
+		width = height = -1;
+
+	_decodeWidth = width;
+	_decodeHeight = height;
+
+	file = g_file_new_for_path([_filename UTF8String]);
+	g_file_read_async(file, (_visible ? G_PRIORITY_DEFAULT : G_PRIORITY_LOW), [_cancellable castedGObject], fileOpened, self);
+	g_object_unref(file);
+}
+
+- (void)og_fileDidOpen:(GFile*)file result:(GAsyncResult*)result
+{
+	GError* err = NULL;
+	GFileInputStream* stream = g_file_read_finish(file, result, &err);
+
+	if (stream == NULL) {
+		[self og_completeWithTexture:nil error:err];
+		g_error_free(err);
+		return;
+	}
+
+	if (_finished) {
+		g_object_unref(stream);
+		[self og_completeWithTexture:nil error:NULL];
+		return;
+	}
+
+	@try {
+		OGInputStream* inputStream = OGWrapperClassAndObjectForGObject(stream);
+
+		[OGdkPixbuf newFromStreamAtScaleAsync:inputStream width:_decodeWidth height:_decodeHeight preserveAspectRatio:true cancellable:_cancellable callback:pixbufReady userData:self];
+	} @finally {
+		g_object_unref(stream);
+	}
+}
+
+- (void)og_pixbufDidLoad:(GAsyncResult*)result
+{
+	GError* err = NULL;
+	GdkPixbuf* pixbuf = gdk_pixbuf_new_from_stream_finish(result, &err);
+	OGdkTexture* texture;
+
+	if (pixbuf == NULL) {
+		[self og_completeWithTexture:nil error:err];
+		g_error_free(err);
+		return;
+	}
+
+	if (_finished) {
+		g_object_unref(pixbuf);
+		[self og_completeWithTexture:nil error:NULL];
+		return;
+	}
+
+	@try {
+		texture = [OGdkTexture textureForPixbuf:OGWrapperClassAndObjectForGObject(pixbuf)];
+	} @finally {
+		g_object_unref(pixbuf);
+	}
+
+	[self og_completeWithTexture:texture error:NULL];
+}
+
+- (void)og_completeWithTexture:(OGdkTexture*)texture error:(const GError*)error
+{
+	OGTKImageDecodeScheduler* scheduler = _scheduler;
+
+	@try {
+#ifdef OF_HAVE_BLOCKS
+		if (!_finished) {
+			OGTKImageDecodeCompletionHandler handler = [_handler retain];
+
+			[self og_finish];
+
+			@try {
+				handler(texture, error);
+			} @finally {
+				[handler release];
+			}
+		}
+#endif
+	} @finally {
+		_running = false;
+		[self og_finish];
+		[scheduler og_requestDidStop:self];
+
+		/* Balances -og_start. */
+		[scheduler release];
+		[self release];
+	}
+}
+
+- (void)og_listItemDidChange
+{
+	if (gtk_list_item_get_item(_listItem) != _boundItem)
+		[self cancel];
+}
+
+- (void)og_detachFromScheduler
+{
+	_scheduler = nil;
+	[_cancellable cancel];
+	[self og_finish];
+}
+
+- (void)og_finish
+{
+	_finished = true;
+
+#ifdef OF_HAVE_BLOCKS
+	[_handler release];
+	_handler = nil;
+#endif
+
+	if (_listItem != NULL) {
+		g_signal_handler_disconnect(_listItem, _notifyHandlerID);
+		g_object_unref(_listItem);
+		_listItem = NULL;
+		_boundItem = NULL;
+	}
+}
+
+@end
+
+@implementation OGTKImageDecodeScheduler
+
++ (instancetype)schedulerWithMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes
+{
+	return [[[self alloc] initWithMaxConcurrentDecodes:maxConcurrentDecodes] autorelease];
+}
+
+- (instancetype)init
+{
+	return [self initWithMaxConcurrentDecodes:0];
+}
+
+- (instancetype)initWithMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes
+{
+	self = [super init];
+
+	@try {
+		if (maxConcurrentDecodes == 0)
+			maxConcurrentDecodes = g_get_num_processors();
+
+		_maxConcurrentDecodes = maxConcurrentDecodes;
+		_pendingRequests = [[OFMutableArray alloc] init];
+		_runningRequests = [[OFMutableArray alloc] init];
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	/* Running requests retain the scheduler, only pending ones are left. */
+	for (OGTKImageDecodeRequest* request in _pendingRequests)
+		[request og_detachFromScheduler];
+
+	[_pendingRequests release];
+	[_runningRequests release];
+
+	[super dealloc];
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (OGTKImageDecodeRequest*)decodeFilename:(OFString*)filename width:(int)width height:(int)height listItem:(OGTKListItem*)listItem completionHandler:(OGTKImageDecodeCompletionHandler)handler
+{
+	OGTKImageDecodeRequest* request = [[[OGTKImageDecodeRequest alloc] og_initWithScheduler:self filename:filename width:width height:height listItem:listItem handler:handler] autorelease];
+
+	[_pendingRequests addObject:request];
+	[self og_startPendingRequests];
+
+	return request;
+}
+
+- (OGTKImageDecodeRequest*)decodeFilename:(OFString*)filename intoPicture:(OGTKPicture*)picture listItem:(OGTKListItem*)listItem
+{
+	GtkWidget* widget = GTK_WIDGET([picture castedGObject]);
+	int scale = gtk_widget_get_scale_factor(widget);
+	int width = gtk_widget_get_width(widget);
+	int height = gtk_widget_get_height(widget);
+
+	if (width > 0 && height > 0) {
+		width *= scale;
+		height *= scale;
+	} else
+		width = height = -1;
+
+	return [self decodeFilename:filename width:width height:height listItem:listItem completionHandler:^(OGdkTexture* texture, const GError* error) {
+		if (texture != nil)
+			[picture setPaintable:GDK_PAINTABLE([texture castedGObject])];
+	}];
+}
+#endif
+
+- (void)cancelAllRequests
+{
+	OFArray OF_GENERIC(OGTKImageDecodeRequest*)* requests = [_pendingRequests arrayByAddingObjectsFromArray:_runningRequests];
+
+	for (OGTKImageDecodeRequest* request in requests)
+		[request cancel];
+}
+
+- (unsigned int)maxConcurrentDecodes
+{
+	return _maxConcurrentDecodes;
+}
+
+- (void)setMaxConcurrentDecodes:(unsigned int)maxConcurrentDecodes
+{
+	if (maxConcurrentDecodes == 0)
+		@throw [OFInvalidArgumentException exception];
+
+	_maxConcurrentDecodes = maxConcurrentDecodes;
+	[self og_startPendingRequests];
+}
+
+- (size_t)pendingCount
+{
+	return [_pendingRequests count];
+}
+
+- (size_t)runningCount
+{
+	return [_runningRequests count];
+}
+
+- (unsigned long long)og_nextSequence
+{
+	return _nextSequence++;
+}
+
+- (void)og_removePendingRequest:(OGTKImageDecodeRequest*)request
+{
+	[_pendingRequests removeObjectIdenticalTo:request];
+}
+
+- (void)og_requestDidStop:(OGTKImageDecodeRequest*)request
+{
+	[_runningRequests removeObjectIdenticalTo:request];
+	[self og_startPendingRequests];
+}
+
+- (void)og_startPendingRequests
+{
+	while ([_runningRequests count] < _maxConcurrentDecodes && [_pendingRequests count] > 0) {
+		size_t count = [_pendingRequests count], best = 0;
+		OGTKImageDecodeRequest* request;
+
+		/* Visible requests first, the newest of them first. */
+		for (size_t i = 1; i < count; i++) {
+			OGTKImageDecodeRequest* candidate = [_pendingRequests objectAtIndex:i];
+			OGTKImageDecodeRequest* current = [_pendingRequests objectAtIndex:best];
+
+			if ([candidate isVisible] != [current isVisible]) {
+				if ([candidate isVisible])
+					best = i;
+			} else if ([candidate og_sequence] > [current og_sequence])
+				best = i;
+		}
+
+		request = [_pendingRequests objectAtIndex:best];
+		[_runningRequests addObject:request];
+		[_pendingRequests removeObjectAtIndex:best];
+
+		[request og_start];
+	}
+}
+
+@end
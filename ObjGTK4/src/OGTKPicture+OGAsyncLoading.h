@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKPicture.h"
+
+@class OGTKImageDecodeScheduler;
+
+/**
+ * Asynchronous variants of -setFilename: and -setFile:.
+ *
+ * The picture shows a placeholder right away, e.g. a low resolution
+ * preview from an `OGdkThumbnailCache`. Once the picture is mapped and
+ * allocated, the image is decoded on a worker thread through an
+ * `OGTKImageDecodeScheduler`, scaled down to the allocated size of the
+ * picture times its scale factor, and replaces the placeholder when it is
+ * ready. Unrealizing the picture cancels a decode that has not finished,
+ * so pictures scrolled out of a list do not keep the decoder busy; the
+ * placeholder stays in that case.
+ *
+ * Setting another image, asynchronously or not, should be preceded by
+ * -cancelAsyncLoading, or the pending image may replace it later.
+ */
+@interface OGTKPicture (OGAsyncLoading)
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * The scheduler used by -setFilenameAsync:placeholder:, shared by all
+ * pictures. It decodes as many images at a time as there are processors.
+ *
+ * @return the shared decode scheduler
+ */
++ (OGTKImageDecodeScheduler*)asyncLoadingScheduler;
+
+/**
+ * Loads an image file asynchronously through the shared scheduler.
+ *
+ * @param filename the path of the image file
+ * @param placeholder the paintable to show until the image is loaded, or
+ *   %NULL to show nothing
+ */
+- (void)setFilenameAsync:(OFString*)filename placeholder:(GdkPaintable*)placeholder;
+
+/**
+ * Loads an image file asynchronously through the given scheduler.
+ *
+ * @param filename the path of the image file
+ * @param placeholder the paintable to show until the image is loaded, or
+ *   %NULL to show nothing
+ * @param scheduler the scheduler to decode the image with
+ */
+- (void)setFilenameAsync:(OFString*)filename placeholder:(GdkPaintable*)placeholder scheduler:(OGTKImageDecodeScheduler*)scheduler;
+
+/**
+ * Loads a local image file asynchronously through the shared scheduler.
+ *
+ * @param file the image file; it must have a local path
+ * @param placeholder the paintable to show until the image is loaded, or
+ *   %NULL to show nothing
+ */
+- (void)setFileAsync:(GFile*)file placeholder:(GdkPaintable*)placeholder;
+
+/**
+ * Cancels loading an image asynchronously. The current paintable stays.
+ */
+- (void)cancelAsyncLoading;
+
+/**
+ * Whether an image is being loaded asynchronously.
+ *
+ * @return whether an asynchronous load is pending
+ */
+- (bool)isLoadingAsync;
+#endif
+
+@end
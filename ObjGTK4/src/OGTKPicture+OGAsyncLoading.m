@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKPicture+OGAsyncLoading.h"
+
+#import <OGdk4/OGdkTexture.h>
+
+#import "OGTKImageDecodeScheduler.h"
+
+#ifdef OF_HAVE_BLOCKS
+static GQuark
+asyncLoadQuark(void)
+{
+	return g_quark_from_static_string("og-gtk-picture-async-load");
+}
+
+/*
+ * The pending load of a picture, owned by the picture through its qdata.
+ * It waits for the first frame in which the picture is allocated, so the
+ * decode size is known, then schedules the decode.
+ */
+@interface OGTKPictureAsyncLoad : OFObject
+{
+	GtkWidget* _widget;
+	OFString* _filename;
+	OGTKImageDecodeScheduler* _scheduler;
+	OGTKImageDecodeRequest* _request;
+	guint _tickCallbackID;
+	gulong _unrealizeHandlerID;
+}
+
+- (instancetype)initWithPicture:(OGTKPicture*)picture filename:(OFString*)filename scheduler:(OGTKImageDecodeScheduler*)scheduler;
+- (bool)og_startIfAllocated;
+- (void)og_tickCallbackRemoved;
+- (void)og_didFinish;
+- (void)cancel;
+- (bool)isPending;
+@end
+
+static gboolean
+tick(GtkWidget* widget, GdkFrameClock* frameClock, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+	OGTKPictureAsyncLoad* load = userData;
+	gboolean result = ([load og_startIfAllocated] ? G_SOURCE_REMOVE : G_SOURCE_CONTINUE);
+
+	objc_autoreleasePoolPop(pool);
+
+	return result;
+}
+
+/* Also called when the widget drops its tick callbacks on destruction. */
+static void
+tickRemoved(gpointer userData)
+{
+	[(OGTKPictureAsyncLoad*)userData og_tickCallbackRemoved];
+}
+
+static void
+unrealize(GtkWidget* widget, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+
+	[(OGTKPictureAsyncLoad*)userData cancel];
+
+	objc_autoreleasePoolPop(pool);
+}
+
+static void
+releaseLoad(gpointer data)
+{
+	OGTKPictureAsyncLoad* load = data;
+
+	[load cancel];
+	[load release];
+}
+
+@implementation OGTKPictureAsyncLoad
+
+- (instancetype)initWithPicture:(OGTKPicture*)picture filename:(OFString*)filename scheduler:(OGTKImageDecodeScheduler*)scheduler
+{
+	self = [super init];
+
+	@try {
+		/*
+		 * Not retained, the load is owned by the widget. The wrapper is
+		 * not kept, as it may be released while the widget lives on.
+		 */
+		_widget = GTK_WIDGET([picture castedGObject]);
+		_filename = [filename copy];
+		_scheduler = [scheduler retain];
+
+		_tickCallbackID = gtk_widget_add_tick_callback(_widget, tick, self, tickRemoved);
+		_unrealizeHandlerID = g_signal_connect(_widget, "unrealize", G_CALLBACK(unrealize), self);
+	} @catch (id e) {
+		[self release];
+		@throw e;
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_request release];
+	[_scheduler release];
+	[_filename release];
+
+	[super dealloc];
+}
+
+- (bool)og_startIfAllocated
+{
+	int scale = gtk_widget_get_scale_factor(_widget);
+	int width = gtk_widget_get_width(_widget);
+	int height = gtk_widget_get_height(_widget);
+
+	if (width <= 0 || height <= 0)
+		return false;
+
+	_request = [[_scheduler decodeFilename:_filename width:width * scale height:height * scale listItem:nil completionHandler:^(OGdkTexture* texture, const GError* error) {
+		if (texture != nil)
+			gtk_picture_set_paintable(GTK_PICTURE(_widget), GDK_PAINTABLE([texture castedGObject]));
+
+		[self og_didFinish];
+	}] retain];
+
+	return true;
+}
+
+- (void)og_tickCallbackRemoved
+{
+	_tickCallbackID = 0;
+}
+
+/*
+ * Drops the load from the widget, which disconnects it. The handler that
+ * calls this keeps the load alive until it returns.
+ */
+- (void)og_didFinish
+{
+	g_object_set_qdata(G_OBJECT(_widget), asyncLoadQuark(), NULL);
+}
+
+- (void)cancel
+{
+	if (_tickCallbackID != 0)
+		gtk_widget_remove_tick_callback(_widget, _tickCallbackID);
+
+	if (_unrealizeHandlerID != 0) {
+		/* Signal handlers are gone already if the picture is being finalized. */
+		if (g_signal_handler_is_connected(_widget, _unrealizeHandlerID))
+			g_signal_handler_disconnect(_widget, _unrealizeHandlerID);
+		_unrealizeHandlerID = 0;
+	}
+
+	[_request cancel];
+}
+
+- (bool)isPending
+{
+	return (_tickCallbackID != 0 || (_request != nil && ![_request isFinished]));
+}
+
+@end
+
+@implementation OGTKPicture (OGAsyncLoading)
+
++ (OGTKImageDecodeScheduler*)asyncLoadingScheduler
+{
+	static OGTKImageDecodeScheduler* scheduler = nil;
+
+	/* Like all widgets, pictures are only used from the main thread. */
+	if (scheduler == nil)
+		scheduler = [[OGTKImageDecodeScheduler alloc] initWithMaxConcurrentDecodes:0];
+
+	return scheduler;
+}
+
+- (void)setFilenameAsync:(OFString*)filename placeholder:(GdkPaintable*)placeholder
+{
+	[self setFilenameAsync:filename placeholder:placeholder scheduler:[OGTKPicture asyncLoadingScheduler]];
+}
+
+- (void)setFilenameAsync:(OFString*)filename placeholder:(GdkPaintable*)placeholder scheduler:(OGTKImageDecodeScheduler*)scheduler
+{
+	OGTKPictureAsyncLoad* load;
+
+	if (filename == nil || scheduler == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	[self cancelAsyncLoading];
+	[self setPaintable:placeholder];
+
+	load = [[OGTKPictureAsyncLoad alloc] initWithPicture:self filename:filename scheduler:scheduler];
+	g_object_set_qdata_full(G_OBJECT([self castedGObject]), asyncLoadQuark(), load, releaseLoad);
+}
+
+- (void)setFileAsync:(GFile*)file placeholder:(GdkPaintable*)placeholder
+{
+	char* path;
+	OFString* filename;
+
+	if (file == NULL || (path = g_file_get_path(file)) == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	@try {
+		filename = [OFString stringWithUTF8String:path];
+	} @finally {
+		g_free(path);
+	}
+
+	[self setFilenameAsync:filename placeholder:placeholder];
+}
+
+- (void)cancelAsyncLoading
+{
+	/* Releasing the load cancels it. */
+	g_object_set_qdata(G_OBJECT([self castedGObject]), asyncLoadQuark(), NULL);
+}
+
+- (bool)isLoadingAsync
+{
+	OGTKPictureAsyncLoad* load = g_object_get_qdata(G_OBJECT([self castedGObject]), asyncLoadQuark());
+
+	return (load != nil && [load isPending]);
+}
+
+@end
+#endif
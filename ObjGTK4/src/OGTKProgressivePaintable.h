@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#import <OGObject/OGObject.h>
+
+@class OGdkPixbufLoader;
+
+#define OG_TYPE_GTK_PROGRESSIVE_PAINTABLE (og_gtk_progressive_paintable_get_type())
+
+GType og_gtk_progressive_paintable_get_type(void);
+
+/**
+ * A `GdkPaintable` that shows the image of a `GdkPixbufLoader` while it is
+ * still being loaded.
+ *
+ * The image is split into tiles of 256×256 pixels, each of which is a
+ * separate memory texture. The paintable listens to the
+ * [signal@GdkPixbuf.PixbufLoader::area-updated] signal and remembers which
+ * tiles were touched; only those are converted and uploaded again. The
+ * tiles are rebuilt when the paintable is drawn, so no matter how often the
+ * loader reports progress, they are rebuilt at most once per frame of the
+ * frame clock of the widget showing the paintable.
+ *
+ * Tiles that were not touched by the loader yet are left transparent. For
+ * animations, only the first frame is shown.
+ *
+ * Set the paintable on a `GtkPicture` and feed the loader with
+ * -[OGdkPixbufLoader writeWithBuf:count:] as data arrives.
+ */
+@interface OGTKProgressivePaintable : OGObject
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
++ (void)load;
+
++ (GTypeClass*)gObjectClass;
+
+/**
+ * Constructors
+ */
++ (instancetype)progressivePaintableWithLoader:(OGdkPixbufLoader*)loader;
+
+/**
+ * Methods
+ */
+
+- (GdkPaintable*)castedGObject;
+
+/**
+ * Whether the loader has allocated its pixbuf, so that the paintable has a
+ * size.
+ *
+ * @return whether the size of the image is known
+ */
+- (bool)isPrepared;
+
+/**
+ * The number of tile textures created since the paintable was created.
+ *
+ * @return the number of tile uploads
+ */
+- (size_t)tileUploadCount;
+
+@end
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGTKSnapshot;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block drawing the cached content.
+ *
+ * @param snapshot a fresh snapshot to draw into
+ */
+typedef void (^OGTKRenderNodeCacheDrawBlock)(OGTKSnapshot* snapshot);
+#endif
+
+/**
+ * Caches the render node tree of content that is expensive to build but
+ * rarely changes, e.g. the text, paths and gradients of a chart widget.
+ *
+ * A widget keeps one cache per static part and calls
+ * -appendToSnapshot:contentVersion:width:height:drawBlock: from its
+ * snapshot function. The draw block only runs if the content version or
+ * the size differs from the cached ones; otherwise the recorded node is
+ * appended again, which is cheap as render nodes are immutable. The widget
+ * increments its content version whenever the state the block draws from
+ * changes.
+ *
+ * The hit and miss counters show whether snapshots caused by other widgets
+ * really reuse the cached nodes.
+ */
+@interface OGTKRenderNodeCache : OFObject
+{
+	GskRenderNode* _node;
+	unsigned long long _contentVersion;
+	int _width;
+	int _height;
+	bool _valid;
+	size_t _hits;
+	size_t _misses;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)renderNodeCache;
+
+/**
+ * Methods
+ */
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Appends the cached content to a snapshot, recording it first if the key
+ * changed.
+ *
+ * @param snapshot the snapshot to append to
+ * @param contentVersion the version of the state the content is drawn from
+ * @param width the width the content is drawn for
+ * @param height the height the content is drawn for
+ * @param drawBlock the block recording the content
+ */
+- (void)appendToSnapshot:(OGTKSnapshot*)snapshot contentVersion:(unsigned long long)contentVersion width:(int)width height:(int)height drawBlock:(OGTKRenderNodeCacheDrawBlock)drawBlock;
+#endif
+
+/**
+ * Drops the cached node, so that the next append records the content again.
+ */
+- (void)invalidate;
+
+/**
+ * The cached node.
+ *
+ * @return the cached node, or %NULL if there is none or the content was
+ *   empty
+ */
+- (GskRenderNode*)node;
+
+/**
+ * The number of appends that reused the cached node.
+ *
+ * @return the number of cache hits
+ */
+- (size_t)hits;
+
+/**
+ * The number of appends that had to record the content.
+ *
+ * @return the number of cache misses
+ */
+- (size_t)misses;
+
+/**
+ * Resets the hit and miss counters to zero.
+ */
+- (void)resetStatistics;
+
+@end
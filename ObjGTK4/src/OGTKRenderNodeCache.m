@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKRenderNodeCache.h"
+
+#import "OGTKSnapshot.h"
+
+@implementation OGTKRenderNodeCache
+
++ (instancetype)renderNodeCache
+{
+	return [[[self alloc] init] autorelease];
+}
+
+- (void)dealloc
+{
+	if (_node != NULL)
+		gsk_render_node_unref(_node);
+
+	[super dealloc];
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (void)appendToSnapshot:(OGTKSnapshot*)snapshot contentVersion:(unsigned long long)contentVersion width:(int)width height:(int)height drawBlock:(OGTKRenderNodeCacheDrawBlock)drawBlock
+{
+	if (snapshot == nil || drawBlock == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	if (_valid && _contentVersion == contentVersion && _width == width && _height == height)
+		_hits++;
+	else {
+		void* pool = objc_autoreleasePoolPush();
+		OGTKSnapshot* recording = [OGTKSnapshot snapshot];
+
+		[self invalidate];
+
+		drawBlock(recording);
+
+		/* Empty content yields no node, which is cached as well. */
+		_node = [recording toNode];
+		_contentVersion = contentVersion;
+		_width = width;
+		_height = height;
+		_valid = true;
+		_misses++;
+
+		objc_autoreleasePoolPop(pool);
+	}
+
+	if (_node != NULL)
+		[snapshot appendNode:_node];
+}
+#endif
+
+- (void)invalidate
+{
+	if (_node != NULL) {
+		gsk_render_node_unref(_node);
+		_node = NULL;
+	}
+
+	_valid = false;
+}
+
+- (GskRenderNode*)node
+{
+	return _node;
+}
+
+- (size_t)hits
+{
+	return _hits;
+}
+
+- (size_t)misses
+{
+	return _misses;
+}
+
+- (void)resetStatistics
+{
+	_hits = 0;
+	_misses = 0;
+}
+
+@end
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKSnapshot.h"
+
+/**
+ * Batched variants of -appendColor:bounds: and -appendTexture:bounds: for
+ * plots and grids with many thousands of primitives.
+ *
+ * Each call takes contiguous C arrays, builds the color or texture nodes
+ * directly and appends them to the snapshot as a single container node, so
+ * the per-primitive cost is one node allocation instead of a message send,
+ * a type check and the snapshot bookkeeping. The primitives are drawn in
+ * array order and are affected by the current transform of the snapshot
+ * like any other appended node.
+ */
+@interface OGTKSnapshot (OGBatchedPrimitives)
+
+/**
+ * Appends rectangles filled with one color each.
+ *
+ * @param colors the colors, one per rectangle
+ * @param rects the rectangles
+ * @param count the number of rectangles
+ */
+- (void)appendColors:(const GdkRGBA*)colors rects:(const graphene_rect_t*)rects count:(size_t)count;
+
+/**
+ * Appends rectangles all filled with the same color.
+ *
+ * @param color the color of all rectangles
+ * @param rects the rectangles
+ * @param count the number of rectangles
+ */
+- (void)appendColor:(const GdkRGBA*)color rects:(const graphene_rect_t*)rects count:(size_t)count;
+
+/**
+ * Appends textures, each scaled to its rectangle.
+ *
+ * @param textures the textures, one per rectangle; the same texture may
+ *   appear several times
+ * @param rects the rectangles
+ * @param count the number of rectangles
+ */
+- (void)appendTextures:(GdkTexture* const*)textures rects:(const graphene_rect_t*)rects count:(size_t)count;
+
+@end
@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKSnapshot+OGBatchedPrimitives.h"
+
+/* Batches up to this size keep their child array on the stack. */
+#define OG_BATCH_STACK_NODES 256
+
+/*
+ * Wraps the children into one container node, appends it and drops the
+ * references of the children, which the container node holds now.
+ */
+static void
+appendChildren(GtkSnapshot* snapshot, GskRenderNode** children, size_t count)
+{
+	if (count == 1)
+		gtk_snapshot_append_node(snapshot, children[0]);
+	else if (count > 1) {
+		GskRenderNode* container = gsk_container_node_new(children, (guint)count);
+
+		gtk_snapshot_append_node(snapshot, container);
+		gsk_render_node_unref(container);
+	}
+
+	for (size_t i = 0; i < count; i++)
+		gsk_render_node_unref(children[i]);
+}
+
+static bool
+isEmptyRect(const graphene_rect_t* rect)
+{
+	return (rect->size.width <= 0 || rect->size.height <= 0);
+}
+
+@implementation OGTKSnapshot (OGBatchedPrimitives)
+
+- (void)og_appendColors:(const GdkRGBA*)colors colorStep:(size_t)colorStep rects:(const graphene_rect_t*)rects count:(size_t)count
+{
+	GskRenderNode* stackChildren[OG_BATCH_STACK_NODES];
+	GskRenderNode** children = stackChildren;
+	size_t childCount = 0;
+
+	if (count == 0)
+		return;
+
+	if (colors == NULL || rects == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	if (count > OG_BATCH_STACK_NODES)
+		children = g_new(GskRenderNode*, count);
+
+	for (size_t i = 0; i < count; i++) {
+		const GdkRGBA* color = &colors[i * colorStep];
+
+		/* These would not draw anything, so save the node. */
+		if (isEmptyRect(&rects[i]) || color->alpha <= 0)
+			continue;
+
+		children[childCount++] = gsk_color_node_new(color, &rects[i]);
+	}
+
+	appendChildren([self castedGObject], children, childCount);
+
+	if (children != stackChildren)
+		g_free(children);
+}
+
+- (void)appendColors:(const GdkRGBA*)colors rects:(const graphene_rect_t*)rects count:(size_t)count
+{
+	[self og_appendColors:colors colorStep:1 rects:rects count:count];
+}
+
+- (void)appendColor:(const GdkRGBA*)color rects:(const graphene_rect_t*)rects count:(size_t)count
+{
+	[self og_appendColors:color colorStep:0 rects:rects count:count];
+}
+
+- (void)appendTextures:(GdkTexture* const*)textures rects:(const graphene_rect_t*)rects count:(size_t)count
+{
+	GskRenderNode* stackChildren[OG_BATCH_STACK_NODES];
+	GskRenderNode** children = stackChildren;
+	size_t childCount = 0;
+
+	if (count == 0)
+		return;
+
+	if (textures == NULL || rects == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	if (count > OG_BATCH_STACK_NODES)
+		children = g_new(GskRenderNode*, count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (textures[i] == NULL || isEmptyRect(&rects[i]))
+			continue;
+
+		children[childCount++] = gsk_texture_node_new(textures[i], &rects[i]);
+	}
+
+	appendChildren([self castedGObject], children, childCount);
+
+	if (children != stackChildren)
+		g_free(children);
+}
+
+@end
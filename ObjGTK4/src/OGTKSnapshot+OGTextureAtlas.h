@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKSnapshot.h"
+
+@class OGdkTextureAtlasEntry;
+
+/**
+ * Drawing of images packed into an `OGdkTextureAtlas`.
+ */
+@interface OGTKSnapshot (OGTextureAtlas)
+
+/**
+ * Draws an atlas entry scaled to the given bounds.
+ *
+ * The whole page texture is appended, positioned so that the entry covers
+ * the bounds, and clipped to the bounds. All entries of a page therefore
+ * share the texture and its upload. Invalid entries are not drawn.
+ *
+ * @param entry the atlas entry to draw
+ * @param bounds the bounds for the image
+ */
+- (void)appendAtlasEntry:(OGdkTextureAtlasEntry*)entry bounds:(const graphene_rect_t*)bounds;
+
+@end
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKSnapshot+OGTextureAtlas.h"
+
+#import <OGdk4/OGdkTexture.h>
+#import <OGdk4/OGdkTextureAtlas.h>
+
+@implementation OGTKSnapshot (OGTextureAtlas)
+
+- (void)appendAtlasEntry:(OGdkTextureAtlasEntry*)entry bounds:(const graphene_rect_t*)bounds
+{
+	OGdkTexture* page = [entry pageTexture];
+	graphene_rect_t rect, pageBounds;
+	float scaleX, scaleY;
+
+	if (page == nil || bounds->size.width <= 0 || bounds->size.height <= 0)
+		return;
+
+	rect = [entry rect];
+	scaleX = bounds->size.width / rect.size.width;
+	scaleY = bounds->size.height / rect.size.height;
+
+	pageBounds = GRAPHENE_RECT_INIT(bounds->origin.x - rect.origin.x * scaleX, bounds->origin.y - rect.origin.y * scaleY, [page width] * scaleX, [page height] * scaleY);
+
+	[self pushClipWithBounds:bounds];
+	[self appendTexture:page bounds:&pageBounds];
+	[self pop];
+}
+
+@end
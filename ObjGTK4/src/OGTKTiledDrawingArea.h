@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#import "OGTKDrawingArea.h"
+
+#define OG_TYPE_GTK_TILED_DRAWING_AREA (og_gtk_tiled_drawing_area_get_type())
+
+GType og_gtk_tiled_drawing_area_get_type(void);
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * A block drawing a part of the content of an `OGTKTiledDrawingArea`.
+ *
+ * The block is called concurrently from several threads, each time with a
+ * different cairo context, so it must only read shared state. The context
+ * is clipped to @area, drawing outside of it is wasted work.
+ *
+ * @param cr the cairo context, in widget coordinates
+ * @param width the width of the widget
+ * @param height the height of the widget
+ * @param area the part of the widget to draw, in widget coordinates
+ */
+typedef void (^OGTKTiledDrawBlock)(cairo_t* cr, int width, int height, const graphene_rect_t* area);
+#endif
+
+/**
+ * A drawing area that rasterizes its cairo drawing in tiles on worker
+ * threads.
+ *
+ * Unlike a plain `OGTKDrawingArea`, whose draw function paints the whole
+ * widget on the main thread for every frame, this widget splits its content
+ * into square tiles, renders the tiles on a shared thread pool into image
+ * surfaces and keeps them as textures. Snapshots only render tiles that were
+ * invalidated with -invalidateRect: and append the cached textures for all
+ * others, so a map or plot that changes in a small area costs a fraction of
+ * a full repaint.
+ *
+ * All tiles are dropped when the size or the scale factor of the widget
+ * changes. The draw function of `GtkDrawingArea` is not used.
+ */
+@interface OGTKTiledDrawingArea : OGTKDrawingArea
+{
+
+}
+
+/**
+ * Functions and class methods
+ */
++ (void)load;
+
++ (GTypeClass*)gObjectClass;
+
+/**
+ * Constructors
+ */
++ (instancetype)tiledDrawingAreaWithTileSize:(int)tileSize;
+
+/**
+ * Methods
+ */
+
+- (GtkDrawingArea*)castedGObject;
+
+#ifdef OF_HAVE_BLOCKS
+/**
+ * Sets the block drawing the content and invalidates all tiles.
+ *
+ * @param drawBlock the thread-safe block drawing the content, or %nil
+ */
+- (void)setDrawBlock:(OGTKTiledDrawBlock)drawBlock;
+#endif
+
+/**
+ * Marks the tiles overlapping a rectangle for rendering and queues a redraw.
+ *
+ * @param rect the rectangle, in widget coordinates
+ */
+- (void)invalidateRect:(const graphene_rect_t*)rect;
+
+/**
+ * Marks all tiles for rendering and queues a redraw.
+ */
+- (void)invalidateAll;
+
+/**
+ * The width and height of a tile in widget coordinates.
+ *
+ * @return the tile size
+ */
+- (int)tileSize;
+
+/**
+ * The number of tiles rendered since the widget was created.
+ *
+ * @return the number of rendered tiles
+ */
+- (size_t)renderedTileCount;
+
+@end
@@ -0,0 +1,392 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <math.h>
+
+#import "OGTKTiledDrawingArea.h"
+
+#define OG_TILED_DEFAULT_TILE_SIZE 256
+
+typedef struct {
+	GtkDrawingArea parentInstance;
+	id drawBlock;
+	int tileSize;
+	int width;
+	int height;
+	int scale;
+	int columns;
+	int rows;
+	GdkTexture** tiles;
+	bool* dirtyTiles;
+	size_t renderedTileCount;
+} OGTKTiledDrawingAreaInstance;
+
+typedef struct {
+	GtkDrawingAreaClass parentClass;
+} OGTKTiledDrawingAreaInstanceClass;
+
+typedef struct {
+	id drawBlock;
+	int width;
+	int height;
+	int scale;
+	gint pending;
+	GMutex mutex;
+	GCond cond;
+	bool done;
+} OGTiledRenderJob;
+
+typedef struct {
+	OGTiledRenderJob* job;
+	int index;
+	graphene_rect_t area;
+	cairo_surface_t* surface;
+} OGTiledRenderTile;
+
+G_DEFINE_TYPE(OGTKTiledDrawingAreaInstance, og_gtk_tiled_drawing_area, GTK_TYPE_DRAWING_AREA)
+
+static void
+renderTile(gpointer data, gpointer userData)
+{
+	void* pool = objc_autoreleasePoolPush();
+	OGTiledRenderTile* tile = data;
+	OGTiledRenderJob* job = tile->job;
+	cairo_surface_t* surface;
+	cairo_t* cr;
+
+	surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, (int)tile->area.size.width * job->scale, (int)tile->area.size.height * job->scale);
+	cairo_surface_set_device_scale(surface, job->scale, job->scale);
+
+	cr = cairo_create(surface);
+	cairo_translate(cr, -tile->area.origin.x, -tile->area.origin.y);
+	cairo_rectangle(cr, tile->area.origin.x, tile->area.origin.y, tile->area.size.width, tile->area.size.height);
+	cairo_clip(cr);
+
+	@try {
+#ifdef OF_HAVE_BLOCKS
+		OGTKTiledDrawBlock drawBlock = job->drawBlock;
+
+		drawBlock(cr, job->width, job->height, &tile->area);
+#endif
+		cairo_destroy(cr);
+		cairo_surface_flush(surface);
+		tile->surface = surface;
+	} @catch (id e) {
+		/* Exceptions cannot leave the worker; the tile is retried on the next frame. */
+		cairo_destroy(cr);
+		cairo_surface_destroy(surface);
+	}
+
+	objc_autoreleasePoolPop(pool);
+
+	if (g_atomic_int_dec_and_test(&job->pending)) {
+		g_mutex_lock(&job->mutex);
+		job->done = true;
+		g_cond_signal(&job->cond);
+		g_mutex_unlock(&job->mutex);
+	}
+}
+
+static GThreadPool*
+sharedPool(void)
+{
+	static GThreadPool* pool = NULL;
+
+	if (g_once_init_enter(&pool)) {
+		GThreadPool* newPool = g_thread_pool_new(renderTile, NULL, (gint)g_get_num_processors(), FALSE, NULL);
+
+		g_once_init_leave(&pool, newPool);
+	}
+
+	return pool;
+}
+
+static GdkTexture*
+newTextureForSurface(cairo_surface_t* surface)
+{
+	int stride = cairo_image_surface_get_stride(surface);
+	int height = cairo_image_surface_get_height(surface);
+	GdkTexture* texture;
+	GBytes* bytes;
+
+	/* The texture shares the pixels, the surface lives as long as the bytes. */
+	bytes = g_bytes_new_with_free_func(cairo_image_surface_get_data(surface), (gsize)stride * height, (GDestroyNotify)cairo_surface_destroy, surface);
+	texture = gdk_memory_texture_new(cairo_image_surface_get_width(surface), height, GDK_MEMORY_DEFAULT, bytes, stride);
+	g_bytes_unref(bytes);
+
+	return texture;
+}
+
+static void
+clearTiles(OGTKTiledDrawingAreaInstance* self)
+{
+	if (self->tiles != NULL)
+		for (int i = 0; i < self->columns * self->rows; i++)
+			g_clear_object(&self->tiles[i]);
+
+	g_clear_pointer(&self->tiles, g_free);
+	g_clear_pointer(&self->dirtyTiles, g_free);
+
+	self->columns = 0;
+	self->rows = 0;
+}
+
+static void
+resetTiles(OGTKTiledDrawingAreaInstance* self, int width, int height, int scale)
+{
+	clearTiles(self);
+
+	self->width = width;
+	self->height = height;
+	self->scale = scale;
+	self->columns = (width + self->tileSize - 1) / self->tileSize;
+	self->rows = (height + self->tileSize - 1) / self->tileSize;
+	self->tiles = g_new0(GdkTexture*, self->columns * self->rows);
+	self->dirtyTiles = g_new0(bool, self->columns * self->rows);
+}
+
+static void
+renderDirtyTiles(OGTKTiledDrawingAreaInstance* self)
+{
+	OGTiledRenderTile* tiles;
+	OGTiledRenderJob job;
+	int count = 0;
+
+	for (int i = 0; i < self->columns * self->rows; i++)
+		if (self->tiles[i] == NULL || self->dirtyTiles[i])
+			count++;
+
+	if (count == 0)
+		return;
+
+	job.drawBlock = self->drawBlock;
+	job.width = self->width;
+	job.height = self->height;
+	job.scale = self->scale;
+	job.done = false;
+	g_atomic_int_set(&job.pending, count);
+	g_mutex_init(&job.mutex);
+	g_cond_init(&job.cond);
+
+	tiles = g_new0(OGTiledRenderTile, count);
+	count = 0;
+
+	for (int row = 0; row < self->rows; row++) {
+		for (int column = 0; column < self->columns; column++) {
+			int index = row * self->columns + column;
+			int x = column * self->tileSize;
+			int y = row * self->tileSize;
+
+			if (self->tiles[index] != NULL && !self->dirtyTiles[index])
+				continue;
+
+			tiles[count].job = &job;
+			tiles[count].index = index;
+			tiles[count].area = GRAPHENE_RECT_INIT(x, y, MIN(self->tileSize, self->width - x), MIN(self->tileSize, self->height - y));
+			count++;
+		}
+	}
+
+	/* A single tile is not worth the round trip through the pool. */
+	if (count == 1)
+		renderTile(&tiles[0], NULL);
+	else
+		for (int i = 0; i < count; i++)
+			g_thread_pool_push(sharedPool(), &tiles[i], NULL);
+
+	g_mutex_lock(&job.mutex);
+	while (!job.done)
+		g_cond_wait(&job.cond, &job.mutex);
+	g_mutex_unlock(&job.mutex);
+
+	g_cond_clear(&job.cond);
+	g_mutex_clear(&job.mutex);
+
+	for (int i = 0; i < count; i++) {
+		int index = tiles[i].index;
+
+		if (tiles[i].surface == NULL)
+			continue;
+
+		g_clear_object(&self->tiles[index]);
+		self->tiles[index] = newTextureForSurface(tiles[i].surface);
+		self->dirtyTiles[index] = false;
+		self->renderedTileCount++;
+	}
+
+	g_free(tiles);
+}
+
+static void
+og_gtk_tiled_drawing_area_snapshot(GtkWidget* widget, GtkSnapshot* snapshot)
+{
+	OGTKTiledDrawingAreaInstance* self = (OGTKTiledDrawingAreaInstance*)widget;
+	int width = gtk_widget_get_width(widget);
+	int height = gtk_widget_get_height(widget);
+	int scale = gtk_widget_get_scale_factor(widget);
+
+	if (self->drawBlock == nil || width <= 0 || height <= 0)
+		return;
+
+	if (width != self->width || height != self->height || scale != self->scale)
+		resetTiles(self, width, height, scale);
+
+	renderDirtyTiles(self);
+
+	for (int row = 0; row < self->rows; row++) {
+		for (int column = 0; column < self->columns; column++) {
+			GdkTexture* tile = self->tiles[row * self->columns + column];
+			int x = column * self->tileSize;
+			int y = row * self->tileSize;
+
+			if (tile == NULL)
+				continue;
+
+			gtk_snapshot_append_texture(snapshot, tile, &GRAPHENE_RECT_INIT(x, y, MIN(self->tileSize, width - x), MIN(self->tileSize, height - y)));
+		}
+	}
+}
+
+static void
+og_gtk_tiled_drawing_area_finalize(GObject* object)
+{
+	OGTKTiledDrawingAreaInstance* self = (OGTKTiledDrawingAreaInstance*)object;
+
+	clearTiles(self);
+	[self->drawBlock release];
+
+	G_OBJECT_CLASS(og_gtk_tiled_drawing_area_parent_class)->finalize(object);
+}
+
+static void
+og_gtk_tiled_drawing_area_class_init(OGTKTiledDrawingAreaInstanceClass* klass)
+{
+	G_OBJECT_CLASS(klass)->finalize = og_gtk_tiled_drawing_area_finalize;
+	GTK_WIDGET_CLASS(klass)->snapshot = og_gtk_tiled_drawing_area_snapshot;
+}
+
+static void
+og_gtk_tiled_drawing_area_init(OGTKTiledDrawingAreaInstance* self)
+{
+	self->tileSize = OG_TILED_DEFAULT_TILE_SIZE;
+}
+
+@implementation OGTKTiledDrawingArea
+
+static GTypeClass *gObjectClass = NULL;
+
++ (void)load
+{
+	GType gtypeToAssociate = OG_TYPE_GTK_TILED_DRAWING_AREA;
+
+	if (gtypeToAssociate == 0)
+		return;
+
+	g_type_set_qdata(gtypeToAssociate, [super wrapperQuark], [self class]);
+}
+
++ (GTypeClass*)gObjectClass
+{
+	if(gObjectClass != NULL)
+		return gObjectClass;
+
+	gObjectClass = g_type_class_ref(OG_TYPE_GTK_TILED_DRAWING_AREA);
+	return gObjectClass;
+}
+
++ (instancetype)tiledDrawingAreaWithTileSize:(int)tileSize
+{
+	if (tileSize < 0)
+		@throw [OFInvalidArgumentException exception];
+
+	GtkDrawingArea* gobjectValue = g_object_new(OG_TYPE_GTK_TILED_DRAWING_AREA, NULL);
+
+	if OF_UNLIKELY(!gobjectValue)
+		@throw [OGObjectGObjectToWrapCreationFailedException exception];
+
+	// Class is derived from GInitiallyUnowned, so this reference is floating. Own it:
+	g_object_ref_sink(gobjectValue);
+
+	if (tileSize > 0)
+		((OGTKTiledDrawingAreaInstance*)gobjectValue)->tileSize = tileSize;
+
+	OGTKTiledDrawingArea* wrapperObject;
+	@try {
+		wrapperObject = [[OGTKTiledDrawingArea alloc] initWithGObject:gobjectValue];
+	} @catch (id e) {
+		g_object_unref(gobjectValue);
+		[wrapperObject release];
+		@throw e;
+	}
+
+	g_object_unref(gobjectValue);
+	return [wrapperObject autorelease];
+}
+
+- (GtkDrawingArea*)castedGObject
+{
+	return G_TYPE_CHECK_INSTANCE_CAST([self gObject], OG_TYPE_GTK_TILED_DRAWING_AREA, GtkDrawingArea);
+}
+
+#ifdef OF_HAVE_BLOCKS
+- (void)setDrawBlock:(OGTKTiledDrawBlock)drawBlock
+{
+	OGTKTiledDrawingAreaInstance* instance = (OGTKTiledDrawingAreaInstance*)[self castedGObject];
+	id oldDrawBlock = instance->drawBlock;
+
+	instance->drawBlock = [drawBlock copy];
+	[oldDrawBlock release];
+
+	[self invalidateAll];
+}
+#endif
+
+- (void)invalidateRect:(const graphene_rect_t*)rect
+{
+	OGTKTiledDrawingAreaInstance* instance = (OGTKTiledDrawingAreaInstance*)[self castedGObject];
+	int firstColumn, lastColumn, firstRow, lastRow;
+
+	if (rect == NULL)
+		@throw [OFInvalidArgumentException exception];
+
+	if (instance->tiles == NULL || rect->size.width <= 0 || rect->size.height <= 0)
+		return;
+
+	if (rect->origin.x >= instance->width || rect->origin.y >= instance->height || rect->origin.x + rect->size.width <= 0 || rect->origin.y + rect->size.height <= 0)
+		return;
+
+	firstColumn = MAX((int)floorf(rect->origin.x), 0) / instance->tileSize;
+	firstRow = MAX((int)floorf(rect->origin.y), 0) / instance->tileSize;
+	lastColumn = MIN((int)ceilf(rect->origin.x + rect->size.width) - 1, instance->width - 1) / instance->tileSize;
+	lastRow = MIN((int)ceilf(rect->origin.y + rect->size.height) - 1, instance->height - 1) / instance->tileSize;
+
+	for (int row = firstRow; row <= lastRow; row++)
+		for (int column = firstColumn; column <= lastColumn; column++)
+			instance->dirtyTiles[row * instance->columns + column] = true;
+
+	gtk_widget_queue_draw(GTK_WIDGET(instance));
+}
+
+- (void)invalidateAll
+{
+	OGTKTiledDrawingAreaInstance* instance = (OGTKTiledDrawingAreaInstance*)[self castedGObject];
+
+	for (int i = 0; i < instance->columns * instance->rows; i++)
+		instance->dirtyTiles[i] = true;
+
+	gtk_widget_queue_draw(GTK_WIDGET(instance));
+}
+
+- (int)tileSize
+{
+	return ((OGTKTiledDrawingAreaInstance*)[self castedGObject])->tileSize;
+}
+
+- (size_t)renderedTileCount
+{
+	return ((OGTKTiledDrawingAreaInstance*)[self castedGObject])->renderedTileCount;
+}
+
+@end
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#import <ObjFW/ObjFW.h>
+
+@class OGdkTexture;
+@class OGskCairoRenderer;
+@class OGTKWidget;
+
+/**
+ * The texture and timings of a widget rendered by an `OGTKWidgetRenderer`.
+ * Times are in microseconds.
+ */
+@interface OGTKWidgetRenderResult : OFObject
+{
+	OGTKWidget* _widget;
+	OGdkTexture* _texture;
+	gint64 _snapshotTime;
+	gint64 _renderTime;
+}
+
+/**
+ * The widget that was rendered.
+ *
+ * @return the widget
+ */
+- (OGTKWidget*)widget;
+
+/**
+ * The rendered contents of the widget.
+ *
+ * @return the texture, or %nil if the widget was not drawn in time or has
+ *   no contents
+ */
+- (OGdkTexture*)texture;
+
+/**
+ * The time spent taking the snapshot of the widget.
+ *
+ * @return the snapshot time
+ */
+- (gint64)snapshotTime;
+
+/**
+ * The time spent rendering the snapshot to the texture.
+ *
+ * @return the render time
+ */
+- (gint64)renderTime;
+
+@end
+
+/**
+ * Renders widget trees to textures, e.g. for thumbnails of dialogs or for
+ * golden image tests.
+ *
+ * GTK 4 only keeps the contents of mapped widgets, so widgets without a
+ * parent are put into a temporary undecorated host window at their natural
+ * size for the duration of -renderWidgets:. Set a size request beforehand
+ * to render them at another size. Widgets that already are in a window are
+ * rendered where they are. All widgets are laid out and drawn in the same
+ * frame, then captured through an `OGTKWidgetPaintable` and rendered with an
+ * `OGskCairoRenderer`. This works headless with a virtual or test display,
+ * no GPU is needed.
+ *
+ * -renderWidgets: runs the default main context until the widgets have been
+ * drawn, so it must be called on the main thread and not from a snapshot or
+ * frame clock handler.
+ */
+@interface OGTKWidgetRenderer : OFObject
+{
+	OGskCairoRenderer* _renderer;
+	GdkDisplay* _rendererDisplay;
+	gint64 _layoutTime;
+	unsigned int _timeout;
+}
+
+/**
+ * Constructors
+ */
++ (instancetype)widgetRenderer;
+
+/**
+ * Methods
+ */
+
+/**
+ * Renders widgets to textures in one pass.
+ *
+ * @param widgets the widgets to render
+ * @return one result per widget, in the same order
+ */
+- (OFArray OF_GENERIC(OGTKWidgetRenderResult*)*)renderWidgets:(OFArray OF_GENERIC(OGTKWidget*)*)widgets;
+
+/**
+ * The time the last call of -renderWidgets: waited for the widgets to be
+ * laid out and drawn, in microseconds.
+ *
+ * @return the layout time
+ */
+- (gint64)layoutTime;
+
+/**
+ * The maximum time to wait for the widgets to be drawn.
+ *
+ * @return the timeout in milliseconds
+ */
+- (unsigned int)timeout;
+
+/**
+ * Sets the maximum time to wait for the widgets to be drawn. Widgets that
+ * were not drawn in time get no texture. The default is 5000.
+ *
+ * @param timeout the timeout in milliseconds
+ */
+- (void)setTimeout:(unsigned int)timeout;
+
+@end
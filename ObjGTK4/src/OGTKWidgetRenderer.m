@@ -0,0 +1,326 @@
+/*
+ * SPDX-FileCopyrightText: 2026 The ObjGTK authors, see AUTHORS file
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#import "OGTKWidgetRenderer.h"
+
+#import <OGdk4/OGdkDisplay.h>
+#import <OGdk4/OGdkTexture.h>
+#import <OGsk4/OGskCairoRenderer.h>
+
+#import "OGTKSnapshot.h"
+#import "OGTKWidget.h"
+#import "OGTKWidgetPaintable.h"
+
+#define OG_WIDGET_RENDERER_DEFAULT_TIMEOUT 5000
+/* Wakes the main context up regularly to check the timeout. */
+#define OG_WIDGET_RENDERER_POLL_INTERVAL 50
+
+typedef struct {
+	GdkFrameClock* frameClock;
+	gulong handler;
+	bool painted;
+} OGFrameWait;
+
+@interface OGTKWidgetRenderResult ()
+- (instancetype)og_initWithWidget:(OGTKWidget*)widget texture:(OGdkTexture*)texture snapshotTime:(gint64)snapshotTime renderTime:(gint64)renderTime;
+@end
+
+static void
+afterPaint(GdkFrameClock* frameClock, gpointer userData)
+{
+	OGFrameWait* wait = userData;
+
+	wait->painted = true;
+}
+
+static void
+freeFrameWait(gpointer data)
+{
+	OGFrameWait* wait = data;
+
+	g_signal_handler_disconnect(wait->frameClock, wait->handler);
+	g_object_unref(wait->frameClock);
+	g_free(wait);
+}
+
+static gboolean
+wakeUp(gpointer userData)
+{
+	return G_SOURCE_CONTINUE;
+}
+
+@implementation OGTKWidgetRenderResult
+
+- (instancetype)og_initWithWidget:(OGTKWidget*)widget texture:(OGdkTexture*)texture snapshotTime:(gint64)snapshotTime renderTime:(gint64)renderTime
+{
+	self = [super init];
+
+	_widget = [widget retain];
+	_texture = [texture retain];
+	_snapshotTime = snapshotTime;
+	_renderTime = renderTime;
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_widget release];
+	[_texture release];
+
+	[super dealloc];
+}
+
+- (OGTKWidget*)widget
+{
+	return _widget;
+}
+
+- (OGdkTexture*)texture
+{
+	return _texture;
+}
+
+- (gint64)snapshotTime
+{
+	return _snapshotTime;
+}
+
+- (gint64)renderTime
+{
+	return _renderTime;
+}
+
+@end
+
+@implementation OGTKWidgetRenderer
+
++ (instancetype)widgetRenderer
+{
+	return [[[self alloc] init] autorelease];
+}
+
+- (instancetype)init
+{
+	self = [super init];
+
+	_timeout = OG_WIDGET_RENDERER_DEFAULT_TIMEOUT;
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_renderer unrealize];
+	[_renderer release];
+
+	[super dealloc];
+}
+
+/*
+ * Runs the main context until every widget is mapped and its frame clock
+ * has painted a frame that includes it, or until the timeout.
+ */
+- (void)og_waitUntilDrawn:(OFArray OF_GENERIC(OGTKWidget*)*)widgets
+{
+	GHashTable* waits = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, freeFrameWait);
+	GHashTable* queued = g_hash_table_new(g_direct_hash, g_direct_equal);
+	gint64 deadline = g_get_monotonic_time() + (gint64)_timeout * 1000;
+	guint wakeUpSource = g_timeout_add(OG_WIDGET_RENDERER_POLL_INTERVAL, wakeUp, NULL);
+
+	for (;;) {
+		bool allPainted = true;
+
+		for (OGTKWidget* widget in widgets) {
+			GtkWidget* gtkWidget = [widget castedGObject];
+			GtkRoot* root = gtk_widget_get_root(gtkWidget);
+			GdkFrameClock* frameClock = gtk_widget_get_frame_clock(gtkWidget);
+			OGFrameWait* wait;
+
+			/* Hidden widgets will not be drawn, so they are not waited for. */
+			if (root == NULL || !gtk_widget_get_visible(GTK_WIDGET(root)) || !gtk_widget_get_visible(gtkWidget))
+				continue;
+
+			if (frameClock == NULL || !gtk_widget_get_mapped(gtkWidget)) {
+				allPainted = false;
+				continue;
+			}
+
+			wait = g_hash_table_lookup(waits, frameClock);
+			if (wait == NULL) {
+				wait = g_new0(OGFrameWait, 1);
+				wait->frameClock = g_object_ref(frameClock);
+				wait->handler = g_signal_connect_after(frameClock, "after-paint", G_CALLBACK(afterPaint), wait);
+				g_hash_table_insert(waits, frameClock, wait);
+			}
+
+			/* Widgets mapped late need a frame of their own. */
+			if (!g_hash_table_contains(queued, gtkWidget)) {
+				g_hash_table_add(queued, gtkWidget);
+				gtk_widget_queue_draw(gtkWidget);
+				wait->painted = false;
+			}
+
+			if (!wait->painted)
+				allPainted = false;
+		}
+
+		if (allPainted || g_get_monotonic_time() >= deadline)
+			break;
+
+		g_main_context_iteration(NULL, TRUE);
+	}
+
+	g_source_remove(wakeUpSource);
+	g_hash_table_unref(queued);
+	g_hash_table_unref(waits);
+}
+
+- (OGskCairoRenderer*)og_rendererForDisplay:(GdkDisplay*)display
+{
+	if (_renderer != nil && _rendererDisplay == display)
+		return _renderer;
+
+	[_renderer unrealize];
+	[_renderer release];
+	_renderer = nil;
+
+	_renderer = [[OGskCairoRenderer cairoRenderer] retain];
+	if (![_renderer realizeForDisplay:OGWrapperClassAndObjectForGObject(display)]) {
+		[_renderer release];
+		_renderer = nil;
+
+		@throw [OFInitializationFailedException exceptionWithClass:[OGskCairoRenderer class]];
+	}
+
+	_rendererDisplay = display;
+
+	return _renderer;
+}
+
+- (OGTKWidgetRenderResult*)og_renderWidget:(OGTKWidget*)widget
+{
+	GtkWidget* gtkWidget = [widget castedGObject];
+	OGdkTexture* texture = nil;
+	gint64 start, snapshotted, rendered;
+	GskRenderNode* node;
+	int width, height;
+
+	start = g_get_monotonic_time();
+
+	if (gtk_widget_get_mapped(gtkWidget)) {
+		OGTKWidgetPaintable* paintable = [OGTKWidgetPaintable widgetPaintableWithWidget:widget];
+		OGTKSnapshot* snapshot = [OGTKSnapshot snapshot];
+
+		width = gdk_paintable_get_intrinsic_width([paintable castedGObject]);
+		height = gdk_paintable_get_intrinsic_height([paintable castedGObject]);
+
+		gdk_paintable_snapshot([paintable castedGObject], [snapshot castedGObject], width, height);
+		node = [snapshot toNode];
+	} else {
+		width = height = 0;
+		node = NULL;
+	}
+
+	snapshotted = g_get_monotonic_time();
+
+	if (node != NULL) {
+		@try {
+			OGskCairoRenderer* renderer = [self og_rendererForDisplay:gtk_widget_get_display(gtkWidget)];
+
+			texture = [renderer renderTextureWithRoot:node viewport:&GRAPHENE_RECT_INIT(0, 0, width, height)];
+		} @finally {
+			gsk_render_node_unref(node);
+		}
+	}
+
+	rendered = g_get_monotonic_time();
+
+	return [[[OGTKWidgetRenderResult alloc] og_initWithWidget:widget texture:texture snapshotTime:snapshotted - start renderTime:rendered - snapshotted] autorelease];
+}
+
+- (OFArray OF_GENERIC(OGTKWidgetRenderResult*)*)renderWidgets:(OFArray OF_GENERIC(OGTKWidget*)*)widgets
+{
+	OFMutableArray* results = [OFMutableArray arrayWithCapacity:[widgets count]];
+	GtkWidget* hostWindow = NULL;
+	GtkWidget* hostFixed = NULL;
+	double hostHeight = 0;
+	gint64 start;
+
+	if (widgets == nil)
+		@throw [OFInvalidArgumentException exception];
+
+	start = g_get_monotonic_time();
+
+	/* Stacks all widgets without a parent in one host window. */
+	for (OGTKWidget* widget in widgets) {
+		GtkWidget* gtkWidget = [widget castedGObject];
+		int height;
+
+		if (gtk_widget_get_parent(gtkWidget) != NULL || GTK_IS_ROOT(gtkWidget))
+			continue;
+
+		if (hostWindow == NULL) {
+			hostWindow = gtk_window_new();
+			hostFixed = gtk_fixed_new();
+
+			gtk_window_set_decorated(GTK_WINDOW(hostWindow), FALSE);
+			gtk_widget_set_can_focus(hostWindow, FALSE);
+			gtk_widget_set_can_target(hostWindow, FALSE);
+			gtk_window_set_child(GTK_WINDOW(hostWindow), hostFixed);
+		}
+
+		/* Stacked below each other, so the host window grows as needed. */
+		gtk_widget_measure(gtkWidget, GTK_ORIENTATION_VERTICAL, -1, NULL, &height, NULL, NULL);
+		gtk_fixed_put(GTK_FIXED(hostFixed), gtkWidget, 0, hostHeight);
+		hostHeight += height;
+	}
+
+	@try {
+		if (hostWindow != NULL)
+			gtk_window_present(GTK_WINDOW(hostWindow));
+
+		[self og_waitUntilDrawn:widgets];
+		_layoutTime = g_get_monotonic_time() - start;
+
+		for (OGTKWidget* widget in widgets) {
+			void* pool = objc_autoreleasePoolPush();
+
+			[results addObject:[self og_renderWidget:widget]];
+
+			objc_autoreleasePoolPop(pool);
+		}
+	} @finally {
+		if (hostWindow != NULL) {
+			GtkWidget* child;
+
+			while ((child = gtk_widget_get_first_child(hostFixed)) != NULL)
+				gtk_fixed_remove(GTK_FIXED(hostFixed), child);
+
+			gtk_window_destroy(GTK_WINDOW(hostWindow));
+		}
+	}
+
+	[results makeImmutable];
+
+	return results;
+}
+
+- (gint64)layoutTime
+{
+	return _layoutTime;
+}
+
+- (unsigned int)timeout
+{
+	return _timeout;
+}
+
+- (void)setTimeout:(unsigned int)timeout
+{
+	_timeout = timeout;
+}
+
+@end
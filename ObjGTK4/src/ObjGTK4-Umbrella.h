@@ -262,3 +262,13 @@
 #import "OGTKWindowControls.h"
 #import "OGTKWindowGroup.h"
 #import "OGTKWindowHandle.h"
+
+// Additional classes
+#import "OGTKImageDecodeScheduler.h"
+#import "OGTKPicture+OGAsyncLoading.h"
+#import "OGTKProgressivePaintable.h"
+#import "OGTKRenderNodeCache.h"
+#import "OGTKSnapshot+OGBatchedPrimitives.h"
+#import "OGTKSnapshot+OGTextureAtlas.h"
+#import "OGTKTiledDrawingArea.h"
+#import "OGTKWidgetRenderer.h"